@@ -84,13 +84,23 @@
 
 #define CLAY_ID_LOCAL(label) CLAY_IDI_LOCAL(label, 0)
 
-#define CLAY_IDI_LOCAL(label, index) Clay__AttachId(Clay__HashString(CLAY_STRING(label), Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&Clay__openLayoutElementStack, Clay__openLayoutElementStack.length - 2))->children.length + 1, Clay__GetOpenLayoutElement()->id))
+#define CLAY_IDI_LOCAL(label, index) Clay__AttachId(Clay__HashString(CLAY_STRING(label), Clay__GetParentElementChildCount() + 1, Clay__GetOpenLayoutElementId()))
 
 #define CLAY__STRING_LENGTH(s) ((sizeof(s) / sizeof((s)[0])) - sizeof((s)[0]))
 
 #define CLAY_STRING(string) (CLAY__INIT(Clay_String) { .length = CLAY__STRING_LENGTH(string), .chars = (string) })
 
-static int CLAY__ELEMENT_DEFINITION_LATCH = 0;
+#if defined(CLAY_WASM)
+#define CLAY__THREAD_LOCAL
+#elif defined(__cplusplus)
+#define CLAY__THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define CLAY__THREAD_LOCAL __declspec(thread)
+#else
+#define CLAY__THREAD_LOCAL __thread
+#endif
+
+static CLAY__THREAD_LOCAL int CLAY__ELEMENT_DEFINITION_LATCH = 0;
 
 #define CLAY__ELEMENT_INTERNAL(...) \
 	for (\
@@ -133,6 +143,7 @@ struct Clay__Alignpointer { char c; void *x; };
 CLAY__ALIGNMENT_STRUCT(bool);
 CLAY__ALIGNMENT_STRUCT(uint8_t);
 CLAY__ALIGNMENT_STRUCT(int32_t);
+CLAY__ALIGNMENT_STRUCT(float);
 
 #ifdef _MSC_VER
 #define CLAY_PACKED_ENUM __pragma(pack(push, 1)) enum __pragma(pack(pop))
@@ -359,6 +370,10 @@ CLAY__TYPEDEF(Clay_CustomElementConfig, struct Clay_CustomElementConfig);
 CLAY__TYPEDEF(Clay_ScrollElementConfig, struct {
     bool horizontal;
     bool vertical;
+    // When virtualItemCount isn't zero, the container's children are only the visible part of a list of that many items,
+    // each virtualItemSize along the layout direction. See Clay_ScrollContainerData.
+    uint32_t virtualItemCount;
+    float virtualItemSize;
 });
 
 // Border
@@ -392,6 +407,33 @@ CLAY__TYPEDEF(Clay_ElementConfig, struct {
 });
 
 // Miscellaneous Structs & Enums ---------------------------------
+// Adjusts the advance of the first character when it is directly followed by the second
+CLAY__TYPEDEF(Clay_KerningPair, struct {
+    uint8_t first;
+    uint8_t second;
+    float adjustment;
+});
+
+// The horizontal advance of every character of a single byte encoding (e.g. ASCII or Latin-1) for one font at one size,
+// see Clay_SetGlyphAdvanceTable
+CLAY__TYPEDEF(Clay_GlyphAdvanceTable, struct {
+    uint16_t fontId;
+    uint16_t fontSize;
+    // The height reported for any text measured with this table
+    float lineHeight;
+    // Indexed by byte value
+    float advances[256];
+    // Optional. Must be sorted by first, then second.
+    Clay_KerningPair *kerningPairs;
+    uint32_t kerningPairCount;
+});
+
+// A single string to be measured by the function passed to Clay_SetMeasureTextBatchFunction
+CLAY__TYPEDEF(Clay_MeasureTextBatchItem, struct {
+    Clay_String text;
+    Clay_TextElementConfig *config;
+});
+
 CLAY__TYPEDEF(Clay_ScrollContainerData, struct {
     // Note: This is a pointer to the real internal scroll position, mutating it may cause a change in final layout.
     // Intended for use with external functionality that modifies scroll position, such as scroll bars or auto scrolling.
@@ -399,6 +441,10 @@ CLAY__TYPEDEF(Clay_ScrollContainerData, struct {
     Clay_Dimensions scrollContainerDimensions;
     Clay_Dimensions contentDimensions;
     Clay_ScrollElementConfig config;
+    // For virtual lists, the items that should be declared as children this frame, from virtualItemsStartIndex up to but
+    // not including virtualItemsEndIndex. Space is reserved for the rest.
+    uint32_t virtualItemsStartIndex;
+    uint32_t virtualItemsEndIndex;
     // Indicates whether an actual scroll container matched the provided ID or if the default struct was returned.
     bool found;
 });
@@ -428,6 +474,79 @@ CLAY__TYPEDEF(Clay_RenderCommandArray, struct {
     Clay_RenderCommand *internalArray;
 });
 
+CLAY__TYPEDEF(Clay_BoundingBoxArray, struct {
+    uint32_t capacity;
+    uint32_t length;
+    Clay_BoundingBox *internalArray;
+});
+
+// The changes between the render commands of two frames, see Clay_EndLayoutDiff.
+// Commands are matched between frames by id, commandType and their order among commands sharing that id and type.
+CLAY__TYPEDEF(Clay_RenderCommandDiff, struct {
+    // All render commands for this frame, the same as the result of Clay_EndLayout
+    Clay_RenderCommandArray renderCommands;
+    // Commands with no matching command in the previous frame
+    Clay_RenderCommandArray added;
+    // Commands from the previous frame with no match in this frame. Only boundingBox, id and commandType are set.
+    Clay_RenderCommandArray removed;
+    // Commands whose config and text are unchanged, but whose bounding box has changed
+    Clay_RenderCommandArray moved;
+    // Commands whose config or text has changed. The bounding box may have changed as well.
+    Clay_RenderCommandArray changed;
+    // A short list of non overlapping screen regions that cover everything that may look different from the previous frame
+    Clay_BoundingBoxArray damageRectangles;
+});
+
+// The packed render command stream written by Clay_PackRenderCommands is a sequence of these headers, each followed by
+// the payload for its commandType. Every command starts on an 8 byte boundary. Colors are packed as 8 bits per channel,
+// with red in the lowest byte.
+CLAY__TYPEDEF(Clay_PackedRenderCommandFlags, enum {
+    // The payload of a rectangle or border is followed by a Clay_CornerRadius
+    CLAY_PACKED_RENDER_COMMAND_FLAG_CORNER_RADIUS = 1,
+});
+
+CLAY__TYPEDEF(Clay_PackedRenderCommand, struct {
+    uint8_t commandType; // A Clay_RenderCommandType
+    uint8_t flags; // Clay_PackedRenderCommandFlags
+    uint16_t size; // In multiples of 8 bytes, including this header, the payload and any padding
+    uint32_t id;
+    Clay_BoundingBox boundingBox;
+});
+
+CLAY__TYPEDEF(Clay_PackedRectangle, struct {
+    uint32_t color;
+});
+
+CLAY__TYPEDEF(Clay_PackedBorder, struct {
+    uint32_t leftColor;
+    uint32_t rightColor;
+    uint32_t topColor;
+    uint32_t bottomColor;
+    uint16_t leftWidth;
+    uint16_t rightWidth;
+    uint16_t topWidth;
+    uint16_t bottomWidth;
+});
+
+// Followed by length bytes of text, which aren't null terminated
+CLAY__TYPEDEF(Clay_PackedText, struct {
+    uint32_t textColor;
+    uint16_t fontId;
+    uint16_t fontSize;
+    uint16_t letterSpacing;
+    uint16_t lineHeight;
+    uint32_t length;
+});
+
+CLAY__TYPEDEF(Clay_PackedImage, struct {
+    void *imageData;
+    Clay_Dimensions sourceDimensions;
+});
+
+CLAY__TYPEDEF(Clay_PackedCustom, struct {
+    Clay_CustomElementConfig *customElementConfig;
+});
+
 CLAY__TYPEDEF(Clay_PointerDataInteractionState, enum {
     CLAY_POINTER_DATA_PRESSED_THIS_FRAME,
     CLAY_POINTER_DATA_PRESSED,
@@ -461,16 +580,25 @@ CLAY__TYPEDEF(Clay_ErrorHandler, struct {
     uintptr_t userData;
 });
 
+// Holds all of the state for a single clay instance. Opaque, created with Clay_CreateContext or Clay_Initialize.
+typedef struct Clay_Context Clay_Context;
+
 // Function Forward Declarations ---------------------------------
 // Public API functions ---
 uint32_t Clay_MinMemorySize(void);
+uint32_t Clay_OptionalFeatureMemorySize(void);
 Clay_Arena Clay_CreateArenaWithCapacityAndMemory(uint32_t capacity, void *offset);
 void Clay_SetPointerState(Clay_Vector2 position, bool pointerDown);
-void Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler);
+Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler);
+Clay_Context* Clay_CreateContext(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler);
+Clay_Context* Clay_GetCurrentContext(void);
+void Clay_SetCurrentContext(Clay_Context* context);
 void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDelta, float deltaTime);
 void Clay_SetLayoutDimensions(Clay_Dimensions dimensions);
 void Clay_BeginLayout(void);
 Clay_RenderCommandArray Clay_EndLayout(void);
+Clay_RenderCommandDiff Clay_EndLayoutDiff(void);
+uint32_t Clay_PackRenderCommands(Clay_RenderCommandArray renderCommands, void *buffer, uint32_t bufferSize);
 Clay_ElementId Clay_GetElementId(Clay_String idString);
 Clay_ElementId Clay_GetElementIdWithIndex(Clay_String idString, uint32_t index);
 bool Clay_Hovered(void);
@@ -478,13 +606,48 @@ void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_Pointer
 bool Clay_PointerOver(Clay_ElementId elementId);
 Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_ElementId id);
 void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_String *text, Clay_TextElementConfig *config));
+void Clay_SetMeasureTextBatchFunction(void (*measureTextBatchFunction)(Clay_MeasureTextBatchItem *items, uint32_t itemCount, Clay_Dimensions *dimensions));
+void Clay_SetParallelForFunction(void (*parallelForFunction)(uint32_t jobCount, void (*job)(uint32_t jobIndex, void *jobData), void *jobData));
+void Clay_SetGlyphAdvanceTable(Clay_GlyphAdvanceTable *table);
+uint32_t Clay_SaveMeasureTextCache(uint32_t fontFingerprint, void *buffer, uint32_t bufferSize);
+bool Clay_LoadMeasureTextCache(uint32_t fontFingerprint, const void *data, uint32_t dataSize);
 void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId));
 Clay_RenderCommand * Clay_RenderCommandArray_Get(Clay_RenderCommandArray* array, int32_t index);
 void Clay_SetDebugModeEnabled(bool enabled);
 bool Clay_IsDebugModeEnabled(void);
 void Clay_SetCullingEnabled(bool enabled);
+void Clay_SetIncrementalLayoutEnabled(bool enabled);
+void Clay_SetTextContentHashingEnabled(bool enabled);
+void Clay_SetWrappedTextCachingEnabled(bool enabled);
+void Clay_SetRenderCommandBatchingEnabled(bool enabled);
+bool Clay_IsFrameUnchanged(void);
+bool Clay_IsScrollAnimationActive(void);
+uint32_t Clay_GetMaxElementCount(void);
 void Clay_SetMaxElementCount(uint32_t maxElementCount);
+uint32_t Clay_GetMaxMeasureTextCacheWordCount(void);
 void Clay_SetMaxMeasureTextCacheWordCount(uint32_t maxMeasureTextCacheWordCount);
+uint32_t Clay_GetMaxScrollContainerCount(void);
+void Clay_SetMaxScrollContainerCount(uint32_t maxScrollContainerCount);
+uint32_t Clay_GetMaxTextElementCount(void);
+void Clay_SetMaxTextElementCount(uint32_t maxTextElementCount);
+uint32_t Clay_GetMaxImageElementCount(void);
+void Clay_SetMaxImageElementCount(uint32_t maxImageElementCount);
+uint32_t Clay_GetMaxFloatingElementCount(void);
+void Clay_SetMaxFloatingElementCount(uint32_t maxFloatingElementCount);
+uint32_t Clay_GetMaxBorderElementCount(void);
+void Clay_SetMaxBorderElementCount(uint32_t maxBorderElementCount);
+uint32_t Clay_GetMaxCustomElementCount(void);
+void Clay_SetMaxCustomElementCount(uint32_t maxCustomElementCount);
+uint32_t Clay_GetMaxPersistedConfigCount(void);
+void Clay_SetMaxPersistedConfigCount(uint32_t maxPersistedConfigCount);
+Clay_LayoutConfig * Clay_PersistLayoutConfig(Clay_LayoutConfig config);
+Clay_RectangleElementConfig * Clay_PersistRectangleConfig(Clay_RectangleElementConfig config);
+Clay_TextElementConfig * Clay_PersistTextConfig(Clay_TextElementConfig config);
+Clay_ImageElementConfig * Clay_PersistImageConfig(Clay_ImageElementConfig config);
+Clay_FloatingElementConfig * Clay_PersistFloatingConfig(Clay_FloatingElementConfig config);
+Clay_CustomElementConfig * Clay_PersistCustomConfig(Clay_CustomElementConfig config);
+Clay_ScrollElementConfig * Clay_PersistScrollConfig(Clay_ScrollElementConfig config);
+Clay_BorderElementConfig * Clay_PersistBorderConfig(Clay_BorderElementConfig config);
 
 // Internal API functions required by macros
 void Clay__OpenElement(void);
@@ -502,6 +665,8 @@ Clay_CustomElementConfig * Clay__StoreCustomElementConfig(Clay_CustomElementConf
 Clay_ScrollElementConfig * Clay__StoreScrollElementConfig(Clay_ScrollElementConfig config);
 Clay_BorderElementConfig * Clay__StoreBorderElementConfig(Clay_BorderElementConfig config);
 Clay_ElementId Clay__HashString(Clay_String key, uint32_t offset, uint32_t seed);
+uint32_t Clay__GetOpenLayoutElementId(void);
+uint32_t Clay__GetParentElementChildCount(void);
 void Clay__Noop(void);
 void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig);
 
@@ -528,13 +693,20 @@ extern uint32_t Clay__debugViewWidth;
 #define CLAY__MAXFLOAT 3.40282346638528859812e+38F
 #endif
 
-bool Clay__warningsEnabled = true;
-uint32_t Clay__maxElementCount = 8192;
-uint32_t Clay__maxMeasureTextCacheWordCount = 16384;
+// Capacities used for contexts created after Clay_SetMaxElementCount / Clay_SetMaxMeasureTextCacheWordCount / Clay_SetMaxScrollContainerCount / Clay_SetMax*ElementCount are called
+uint32_t Clay__defaultMaxElementCount = 8192;
+uint32_t Clay__defaultMaxMeasureTextCacheWordCount = 16384;
+uint32_t Clay__defaultMaxScrollContainerCount = 10;
+// Per category capacities, never more than the max element count. 0 lets the category hold as many elements as the max element count
+uint32_t Clay__defaultMaxTextElementCount = 4096;
+uint32_t Clay__defaultMaxImageElementCount = 1024;
+uint32_t Clay__defaultMaxFloatingElementCount = 256;
+uint32_t Clay__defaultMaxBorderElementCount = 1024;
+uint32_t Clay__defaultMaxCustomElementCount = 1024;
+uint32_t Clay__defaultMaxPersistedConfigCount = 64;
 void Clay__ErrorHandlerFunctionDefault(Clay_ErrorData errorText) {
     (void) errorText;
 }
-Clay_ErrorHandler Clay__errorHandler = { .errorHandlerFunction = Clay__ErrorHandlerFunctionDefault };
 
 void Clay__Noop(void) {}
 
@@ -547,8 +719,6 @@ CLAY__TYPEDEF(Clay_BooleanWarnings, struct {
     bool maxTextMeasureCacheExceeded;
 });
 
-Clay_BooleanWarnings Clay__booleanWarnings;
-
 CLAY__TYPEDEF(Clay__Warning, struct {
     Clay_String baseMessage;
     Clay_String dynamicMessage;
@@ -563,27 +733,15 @@ CLAY__TYPEDEF(Clay__WarningArray, struct {
     Clay__Warning *internalArray;
 });
 
+// Defined after Clay_Context, as they report errors through the current context's error handler
+void* Clay__Array_Allocate_Arena(uint32_t capacity, uint32_t itemSize, uint32_t alignment, Clay_Arena *arena);
+bool Clay__Array_RangeCheck(int index, uint32_t length);
+bool Clay__Array_AddCapacityCheck(uint32_t length, uint32_t capacity);
+
 Clay__WarningArray Clay__WarningArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
-    size_t totalSizeBytes = capacity * sizeof(Clay_String);
-    Clay__WarningArray array = {.capacity = capacity, .length = 0};
-    uintptr_t nextAllocAddress = arena->nextAllocation + (uintptr_t)arena->memory;
-    uintptr_t arenaOffsetAligned = nextAllocAddress + (CLAY__ALIGNMENT(Clay_String) - (nextAllocAddress % CLAY__ALIGNMENT(Clay_String)));
-    arenaOffsetAligned -= (uintptr_t)arena->memory;
-    if (arenaOffsetAligned + totalSizeBytes <= arena->capacity) {
-        array.internalArray = (Clay__Warning*)((uintptr_t)arena->memory + (uintptr_t)arenaOffsetAligned);
-        arena->nextAllocation = arenaOffsetAligned + totalSizeBytes;
-    }
-    else {
-        Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-            .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
-            .errorText = CLAY_STRING("Clay attempted to allocate memory in its arena, but ran out of capacity. Try increasing the capacity of the arena passed to Clay_Initialize()"),
-            .userData = Clay__errorHandler.userData });
-    }
-    return array;
+    return CLAY__INIT(Clay__WarningArray){.capacity = capacity, .length = 0, .internalArray = (Clay__Warning *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__Warning), CLAY__ALIGNMENT(Clay__Warning), arena)};
 }
 
-Clay__WarningArray Clay_warnings = {0};
-
 Clay__Warning *Clay__WarningArray_Add(Clay__WarningArray *array, Clay__Warning item)
 {
     if (array->length < array->capacity) {
@@ -593,49 +751,6 @@ Clay__Warning *Clay__WarningArray_Add(Clay__WarningArray *array, Clay__Warning i
     return &CLAY__WARNING_DEFAULT;
 }
 
-void* Clay__Array_Allocate_Arena(uint32_t capacity, uint32_t itemSize, uint32_t alignment, Clay_Arena *arena)
-{
-    size_t totalSizeBytes = capacity * itemSize;
-    uintptr_t nextAllocAddress = arena->nextAllocation + (uintptr_t)arena->memory;
-    uintptr_t arenaOffsetAligned = nextAllocAddress + (alignment - (nextAllocAddress % alignment));
-    arenaOffsetAligned -= (uintptr_t)arena->memory;
-    if (arenaOffsetAligned + totalSizeBytes <= arena->capacity) {
-        arena->nextAllocation = arenaOffsetAligned + totalSizeBytes;
-        return (void*)((uintptr_t)arena->memory + (uintptr_t)arenaOffsetAligned);
-    }
-    else {
-        Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
-                .errorText = CLAY_STRING("Clay attempted to allocate memory in its arena, but ran out of capacity. Try increasing the capacity of the arena passed to Clay_Initialize()"),
-                .userData = Clay__errorHandler.userData });
-    }
-    return CLAY__NULL;
-}
-
-bool Clay__Array_RangeCheck(int index, uint32_t length)
-{
-    if (index < length && index >= 0) {
-        return true;
-    }
-    Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-            .errorType = CLAY_ERROR_TYPE_INTERNAL_ERROR,
-            .errorText = CLAY_STRING("Clay attempted to make an out of bounds array access. This is an internal error and is likely a bug."),
-            .userData = Clay__errorHandler.userData });
-    return false;
-}
-
-bool Clay__Array_AddCapacityCheck(uint32_t length, uint32_t capacity)
-{
-    if (length < capacity) {
-        return true;
-    }
-    Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-        .errorType = CLAY_ERROR_TYPE_INTERNAL_ERROR,
-        .errorText = CLAY_STRING("Clay attempted to make an out of bounds array access. This is an internal error and is likely a bug."),
-        .userData = Clay__errorHandler.userData });
-    return false;
-}
-
 bool CLAY__BOOL_DEFAULT = false;
 
 // __GENERATED__ template array_define,array_allocate TYPE=bool NAME=Clay__BoolArray
@@ -929,6 +1044,39 @@ Clay__WrappedTextLine *Clay__WrappedTextLineArray_Get(Clay__WrappedTextLineArray
 #pragma endregion
 // __GENERATED__ template
 
+// Wrapped lines kept across frames for incremental layout. Offsets are stored rather than pointers, as the text itself may move between frames.
+CLAY__TYPEDEF(Clay__CachedTextLine, struct {
+    Clay_Dimensions dimensions;
+    uint32_t startOffset;
+    uint32_t length;
+});
+
+Clay__CachedTextLine CLAY__CACHED_TEXT_LINE_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add,array_get TYPE=Clay__CachedTextLine NAME=Clay__CachedTextLineArray DEFAULT_VALUE=&CLAY__CACHED_TEXT_LINE_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__CachedTextLineArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__CachedTextLine *internalArray;
+});
+Clay__CachedTextLineArray Clay__CachedTextLineArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__CachedTextLineArray){.capacity = capacity, .length = 0, .internalArray = (Clay__CachedTextLine *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__CachedTextLine), CLAY__ALIGNMENT(Clay__CachedTextLine), arena)};
+}
+Clay__CachedTextLine *Clay__CachedTextLineArray_Add(Clay__CachedTextLineArray *array, Clay__CachedTextLine item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__CACHED_TEXT_LINE_DEFAULT;
+}
+Clay__CachedTextLine *Clay__CachedTextLineArray_Get(Clay__CachedTextLineArray *array, int index) {
+    return Clay__Array_RangeCheck(index, array->length) ? &array->internalArray[index] : &CLAY__CACHED_TEXT_LINE_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
 CLAY__TYPEDEF(Clay__TextElementData, struct {
     Clay_String text;
     Clay_Dimensions preferredDimensions;
@@ -962,6 +1110,137 @@ Clay__TextElementData *Clay__TextElementDataArray_Add(Clay__TextElementDataArray
 #pragma endregion
 // __GENERATED__ template
 
+Clay_MeasureTextBatchItem CLAY__MEASURE_TEXT_BATCH_ITEM_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay_MeasureTextBatchItem NAME=Clay__MeasureTextBatchItemArray DEFAULT_VALUE=&CLAY__MEASURE_TEXT_BATCH_ITEM_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__MeasureTextBatchItemArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay_MeasureTextBatchItem *internalArray;
+});
+Clay__MeasureTextBatchItemArray Clay__MeasureTextBatchItemArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__MeasureTextBatchItemArray){.capacity = capacity, .length = 0, .internalArray = (Clay_MeasureTextBatchItem *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay_MeasureTextBatchItem), CLAY__ALIGNMENT(Clay_MeasureTextBatchItem), arena)};
+}
+Clay_MeasureTextBatchItem *Clay__MeasureTextBatchItemArray_Add(Clay__MeasureTextBatchItemArray *array, Clay_MeasureTextBatchItem item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__MEASURE_TEXT_BATCH_ITEM_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
+// The batch is measured early if it fills up, so it doesn't need to hold every word declared in a frame
+#define CLAY__MEASURE_TEXT_BATCH_SIZE 1024
+
+// Identifies a word and the font settings it was measured with. The id picks the slot in the word cache, the length and
+// a second, independently computed hash are compared as well so that two words whose ids collide don't share a size.
+CLAY__TYPEDEF(Clay__MeasuredWordKey, struct {
+    uint32_t id; // 0 for an empty slot
+    uint32_t length;
+    uint32_t checkHash;
+});
+
+// Where the result of a batched measurement is written once the batch function has run
+CLAY__TYPEDEF(Clay__MeasureTextBatchTarget, struct {
+    int32_t cacheItemIndex;
+    int32_t batchItemIndex; // Words that are queued more than once are measured once, and share an item in the batch
+    int32_t measuredWordIndex; // -1 if the word isn't stored in the measured word list
+    bool isSpaceWidth; // Measures the width of a space in the cache item's config, which is added to the words that follow it
+    bool followedBySpace; // The word is followed by a space whose width was queued along with it
+    Clay__MeasuredWordKey wordKey; // The measurement is also stored in the word cache under this key, unless its id is 0
+});
+
+Clay__MeasureTextBatchTarget CLAY__MEASURE_TEXT_BATCH_TARGET_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay__MeasureTextBatchTarget NAME=Clay__MeasureTextBatchTargetArray DEFAULT_VALUE=&CLAY__MEASURE_TEXT_BATCH_TARGET_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__MeasureTextBatchTargetArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__MeasureTextBatchTarget *internalArray;
+});
+Clay__MeasureTextBatchTargetArray Clay__MeasureTextBatchTargetArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__MeasureTextBatchTargetArray){.capacity = capacity, .length = 0, .internalArray = (Clay__MeasureTextBatchTarget *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__MeasureTextBatchTarget), CLAY__ALIGNMENT(Clay__MeasureTextBatchTarget), arena)};
+}
+Clay__MeasureTextBatchTarget *Clay__MeasureTextBatchTargetArray_Add(Clay__MeasureTextBatchTargetArray *array, Clay__MeasureTextBatchTarget item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__MEASURE_TEXT_BATCH_TARGET_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
+// A slot in the table of words queued in the current batch, looked up by word key
+CLAY__TYPEDEF(Clay__MeasureTextBatchSlot, struct {
+    Clay__MeasuredWordKey wordKey; // Id 0 for an empty slot
+    int32_t batchItemIndex;
+});
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__MeasureTextBatchSlot NAME=Clay__MeasureTextBatchSlotArray DEFAULT_VALUE={0}
+#pragma region generated
+CLAY__TYPEDEF(Clay__MeasureTextBatchSlotArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__MeasureTextBatchSlot *internalArray;
+});
+Clay__MeasureTextBatchSlotArray Clay__MeasureTextBatchSlotArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__MeasureTextBatchSlotArray){.capacity = capacity, .length = 0, .internalArray = (Clay__MeasureTextBatchSlot *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__MeasureTextBatchSlot), CLAY__ALIGNMENT(Clay__MeasureTextBatchSlot), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
+Clay_Dimensions CLAY__DIMENSIONS_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay_Dimensions NAME=Clay__DimensionsArray DEFAULT_VALUE=&CLAY__DIMENSIONS_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__DimensionsArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay_Dimensions *internalArray;
+});
+Clay__DimensionsArray Clay__DimensionsArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__DimensionsArray){.capacity = capacity, .length = 0, .internalArray = (Clay_Dimensions *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay_Dimensions), CLAY__ALIGNMENT(Clay_Dimensions), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
+CLAY__TYPEDEF(Clay__GlyphAdvanceTableEntry, struct {
+    Clay_GlyphAdvanceTable *table;
+    uint32_t kerningFirstMask[8]; // One bit for each byte value that appears first in any of the table's kerning pairs
+});
+
+Clay__GlyphAdvanceTableEntry CLAY__GLYPH_ADVANCE_TABLE_ENTRY_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay__GlyphAdvanceTableEntry NAME=Clay__GlyphAdvanceTableEntryArray DEFAULT_VALUE=&CLAY__GLYPH_ADVANCE_TABLE_ENTRY_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__GlyphAdvanceTableEntryArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__GlyphAdvanceTableEntry *internalArray;
+});
+Clay__GlyphAdvanceTableEntryArray Clay__GlyphAdvanceTableEntryArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__GlyphAdvanceTableEntryArray){.capacity = capacity, .length = 0, .internalArray = (Clay__GlyphAdvanceTableEntry *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__GlyphAdvanceTableEntry), CLAY__ALIGNMENT(Clay__GlyphAdvanceTableEntry), arena)};
+}
+Clay__GlyphAdvanceTableEntry *Clay__GlyphAdvanceTableEntryArray_Add(Clay__GlyphAdvanceTableEntryArray *array, Clay__GlyphAdvanceTableEntry item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__GLYPH_ADVANCE_TABLE_ENTRY_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
 Clay_BorderElementConfig CLAY__BORDER_ELEMENT_CONFIG_DEFAULT = {0};
 
 // __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay_BorderElementConfig NAME=Clay__BorderElementConfigArray DEFAULT_VALUE=&CLAY__BORDER_ELEMENT_CONFIG_DEFAULT
@@ -985,11 +1264,102 @@ Clay_BorderElementConfig *Clay__BorderElementConfigArray_Add(Clay__BorderElement
 #pragma endregion
 // __GENERATED__ template
 
+#define CLAY__CONFIG_INTERN_TABLE_SIZE 256
+
+// A slot in the per frame table of stored configs. Configs are looked up by the hash of their bytes, so elements declared
+// with identical configs share a single stored copy.
+CLAY__TYPEDEF(Clay__ConfigInternSlot, struct {
+    uint32_t hash;
+    Clay__ElementConfigType type; // CLAY__ELEMENT_CONFIG_TYPE_NONE for layout configs
+    void *config;
+});
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__ConfigInternSlot NAME=Clay__ConfigInternSlotArray DEFAULT_VALUE={0}
+#pragma region generated
+CLAY__TYPEDEF(Clay__ConfigInternSlotArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__ConfigInternSlot *internalArray;
+});
+Clay__ConfigInternSlotArray Clay__ConfigInternSlotArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__ConfigInternSlotArray){.capacity = capacity, .length = 0, .internalArray = (Clay__ConfigInternSlot *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__ConfigInternSlot), CLAY__ALIGNMENT(Clay__ConfigInternSlot), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
+// A config registered with one of the Clay_Persist*Config functions, stored for the lifetime of the context
+CLAY__TYPEDEF(Clay__ElementConfigValue, union {
+    Clay_LayoutConfig layoutConfig;
+    Clay_RectangleElementConfig rectangleElementConfig;
+    Clay_TextElementConfig textElementConfig;
+    Clay_ImageElementConfig imageElementConfig;
+    Clay_FloatingElementConfig floatingElementConfig;
+    Clay_CustomElementConfig customElementConfig;
+    Clay_ScrollElementConfig scrollElementConfig;
+    Clay_BorderElementConfig borderElementConfig;
+});
+
+CLAY__TYPEDEF(Clay__PersistedConfig, struct {
+    uint32_t hash;
+    Clay__ElementConfigType type;
+    Clay__ElementConfigValue config;
+});
+
+Clay__PersistedConfig CLAY__PERSISTED_CONFIG_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay__PersistedConfig NAME=Clay__PersistedConfigArray DEFAULT_VALUE=&CLAY__PERSISTED_CONFIG_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__PersistedConfigArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__PersistedConfig *internalArray;
+});
+Clay__PersistedConfigArray Clay__PersistedConfigArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__PersistedConfigArray){.capacity = capacity, .length = 0, .internalArray = (Clay__PersistedConfig *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__PersistedConfig), CLAY__ALIGNMENT(Clay__PersistedConfig), arena)};
+}
+Clay__PersistedConfig *Clay__PersistedConfigArray_Add(Clay__PersistedConfigArray *array, Clay__PersistedConfig item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__PERSISTED_CONFIG_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
 CLAY__TYPEDEF(Clay__LayoutElementChildren, struct {
     int32_t *elements;
     uint16_t length;
 });
 
+// The results of the sizing passes from the previous frame, used by incremental layout. See Clay_SetIncrementalLayoutEnabled.
+CLAY__TYPEDEF(Clay__LayoutCacheData, struct {
+    uint32_t layoutHash;
+    uint32_t validGeneration;
+    Clay_Dimensions dimensions;
+    float contentHeight; // Height after text wrapping and propagation, before sizing along the Y axis
+    int32_t wrappedLinesStartIndex;
+    uint32_t wrappedLinesCount;
+    bool subtreeUnchanged;
+    bool restored;
+});
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__LayoutCacheData NAME=Clay__LayoutCacheDataArray
+#pragma region generated
+CLAY__TYPEDEF(Clay__LayoutCacheDataArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__LayoutCacheData *internalArray;
+});
+Clay__LayoutCacheDataArray Clay__LayoutCacheDataArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__LayoutCacheDataArray){.capacity = capacity, .length = 0, .internalArray = (Clay__LayoutCacheData *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__LayoutCacheData), CLAY__ALIGNMENT(Clay__LayoutCacheData), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
 CLAY__TYPEDEF(Clay_LayoutElement, struct {
     union {
         Clay__LayoutElementChildren children;
@@ -1001,6 +1371,9 @@ CLAY__TYPEDEF(Clay_LayoutElement, struct {
     Clay__ElementConfigArraySlice elementConfigs;
     uint32_t configsEnabled;
     uint32_t id;
+    uint32_t layoutHash;
+    Clay__LayoutCacheData *layoutCache;
+    bool subtreeRequiresLayout; // Set when the children must be laid out even if this element is off screen
 });
 
 Clay_LayoutElement CLAY__LAYOUT_ELEMENT_DEFAULT = {0};
@@ -1064,6 +1437,23 @@ Clay_LayoutElement* Clay__LayoutElementPointerArray_RemoveSwapback(Clay__LayoutE
 
 Clay_RenderCommand CLAY__RENDER_COMMAND_DEFAULT = {0};
 
+Clay_BoundingBox CLAY__BOUNDING_BOX_DEFAULT = {0};
+
+// __GENERATED__ template array_allocate,array_add TYPE=Clay_BoundingBox NAME=Clay_BoundingBoxArray DEFAULT_VALUE=&CLAY__BOUNDING_BOX_DEFAULT
+#pragma region generated
+Clay_BoundingBoxArray Clay_BoundingBoxArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay_BoundingBoxArray){.capacity = capacity, .length = 0, .internalArray = (Clay_BoundingBox *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay_BoundingBox), CLAY__ALIGNMENT(Clay_BoundingBox), arena)};
+}
+Clay_BoundingBox *Clay_BoundingBoxArray_Add(Clay_BoundingBoxArray *array, Clay_BoundingBox item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__BOUNDING_BOX_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
 // __GENERATED__ template array_allocate,array_add,array_get TYPE=Clay_RenderCommand NAME=Clay_RenderCommandArray DEFAULT_VALUE=&CLAY__RENDER_COMMAND_DEFAULT
 #pragma region generated
 Clay_RenderCommandArray Clay_RenderCommandArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
@@ -1093,6 +1483,8 @@ CLAY__TYPEDEF(Clay__ScrollContainerDataInternal, struct {
     Clay_Vector2 previousDelta;
     float momentumTime;
     uint32_t elementId;
+    uint32_t virtualItemsStartIndex;
+    uint32_t virtualItemsEndIndex;
     bool openThisFrame;
     bool pointerScrollActive;
 });
@@ -1168,30 +1560,52 @@ Clay__DebugElementData *Clay__DebugElementDataArray_Get(Clay__DebugElementDataAr
 #pragma endregion
 // __GENERATED__ template
 
-CLAY__TYPEDEF(Clay_LayoutElementHashMapItem, struct { // todo get this struct into a single cache line
-    Clay_BoundingBox boundingBox;
+// The element hash map is split into a hot table of fixed size slots that is probed on every lookup, and this cold
+// per element data that is only touched by hover handlers and the debug view. When incremental layout is enabled, each item
+// has a layout cache at the same index in layoutCaches.
+CLAY__TYPEDEF(Clay_LayoutElementHashMapItem, struct {
     Clay_ElementId elementId;
-    Clay_LayoutElement* layoutElement;
     void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData);
     intptr_t hoverFunctionUserData;
-    int32_t nextIndex;
     uint32_t generation;
     Clay__DebugElementData *debugData;
 });
 
-Clay_LayoutElementHashMapItem CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT = { .layoutElement = &CLAY__LAYOUT_ELEMENT_DEFAULT };
+Clay_LayoutElementHashMapItem CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT = {0};
 
-// __GENERATED__ template array_define,array_allocate,array_get,array_add TYPE=Clay_LayoutElementHashMapItem NAME=Clay__LayoutElementHashMapItemArray DEFAULT_VALUE=&CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT
+// 32 bytes, so two slots share a 64 byte cache line. The table is open addressed with linear probing, which keeps
+// collisions for an id in the same or the neighbouring cache line instead of chasing a chain through the item array.
+CLAY__TYPEDEF(Clay__LayoutElementHashMapSlot, struct {
+    uint32_t id;
+    int32_t itemIndex; // Index into layoutElementsHashMapInternal, -1 if the slot is empty
+    Clay_LayoutElement *layoutElement;
+    Clay_BoundingBox boundingBox;
+});
+
+Clay__LayoutElementHashMapSlot CLAY__LAYOUT_ELEMENT_HASH_MAP_SLOT_DEFAULT = { .itemIndex = -1, .layoutElement = &CLAY__LAYOUT_ELEMENT_DEFAULT };
+
+// __GENERATED__ template array_define TYPE=Clay__LayoutElementHashMapSlot NAME=Clay__LayoutElementHashMapSlotArray
 #pragma region generated
-CLAY__TYPEDEF(Clay__LayoutElementHashMapItemArray, struct
+CLAY__TYPEDEF(Clay__LayoutElementHashMapSlotArray, struct
 {
 	uint32_t capacity;
 	uint32_t length;
-	Clay_LayoutElementHashMapItem *internalArray;
+	Clay__LayoutElementHashMapSlot *internalArray;
 });
-Clay__LayoutElementHashMapItemArray Clay__LayoutElementHashMapItemArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
-    return CLAY__INIT(Clay__LayoutElementHashMapItemArray){.capacity = capacity, .length = 0, .internalArray = (Clay_LayoutElementHashMapItem *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay_LayoutElementHashMapItem), CLAY__ALIGNMENT(Clay_LayoutElementHashMapItem), arena)};
-}
+#pragma endregion
+// __GENERATED__ template
+
+// __GENERATED__ template array_define,array_allocate,array_get,array_add TYPE=Clay_LayoutElementHashMapItem NAME=Clay__LayoutElementHashMapItemArray DEFAULT_VALUE=&CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__LayoutElementHashMapItemArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay_LayoutElementHashMapItem *internalArray;
+});
+Clay__LayoutElementHashMapItemArray Clay__LayoutElementHashMapItemArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__LayoutElementHashMapItemArray){.capacity = capacity, .length = 0, .internalArray = (Clay_LayoutElementHashMapItem *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay_LayoutElementHashMapItem), CLAY__ALIGNMENT(Clay_LayoutElementHashMapItem), arena)};
+}
 Clay_LayoutElementHashMapItem *Clay__LayoutElementHashMapItemArray_Get(Clay__LayoutElementHashMapItemArray *array, int index) {
     return Clay__Array_RangeCheck(index, array->length) ? &array->internalArray[index] : &CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT;
 }
@@ -1209,10 +1623,11 @@ CLAY__TYPEDEF(Clay__MeasuredWord, struct {
     uint32_t startOffset;
     uint32_t length;
     float width;
-    int32_t next;
+    float widthBefore; // The total width of the words before this one, since the start of the text or the last newline
+    uint32_t lineBreakIndex; // The index of the next newline in the cache item's words, or the word count if there isn't one
 });
 
-Clay__MeasuredWord CLAY__MEASURED_WORD_DEFAULT = { .next = -1 };
+Clay__MeasuredWord CLAY__MEASURED_WORD_DEFAULT = {0};
 
 // __GENERATED__ template array_define,array_allocate,array_get,array_set,array_add TYPE=Clay__MeasuredWord NAME=Clay__MeasuredWordArray DEFAULT_VALUE=&CLAY__MEASURED_WORD_DEFAULT
 #pragma region generated
@@ -1247,6 +1662,7 @@ Clay__MeasuredWord *Clay__MeasuredWordArray_Add(Clay__MeasuredWordArray *array,
 CLAY__TYPEDEF(Clay__MeasureTextCacheItem, struct {
     Clay_Dimensions unwrappedDimensions;
     int32_t measuredWordsStartIndex;
+    uint32_t measuredWordsCount;
     // Hash map data
     uint32_t id;
     int32_t nextIndex;
@@ -1285,6 +1701,51 @@ void Clay__MeasureTextCacheItemArray_Set(Clay__MeasureTextCacheItemArray *array,
 #pragma endregion
 // __GENERATED__ template
 
+// The lines a measured string was wrapped into in the most recent frame, at the same index as its item in
+// measureTextHashMapInternal. See Clay_SetWrappedTextCachingEnabled and Clay__FindWrappedLines.
+CLAY__TYPEDEF(Clay__WrappedLinesCacheEntry, struct {
+    float wrappedWidth;
+    uint32_t wrappedLinesGeneration;
+    uint32_t wrappedLinesStartIndex;
+    uint32_t wrappedLinesCount;
+});
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__WrappedLinesCacheEntry NAME=Clay__WrappedLinesCacheEntryArray
+#pragma region generated
+CLAY__TYPEDEF(Clay__WrappedLinesCacheEntryArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__WrappedLinesCacheEntry *internalArray;
+});
+Clay__WrappedLinesCacheEntryArray Clay__WrappedLinesCacheEntryArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__WrappedLinesCacheEntryArray){.capacity = capacity, .length = 0, .internalArray = (Clay__WrappedLinesCacheEntry *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__WrappedLinesCacheEntry), CLAY__ALIGNMENT(Clay__WrappedLinesCacheEntry), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
+// Word widths are shared by every string that contains the word, keyed on the word's bytes and the font settings
+CLAY__TYPEDEF(Clay__MeasuredWordCacheEntry, struct {
+    Clay__MeasuredWordKey key; // Id 0 for an empty slot
+    Clay_Dimensions dimensions;
+});
+
+Clay__MeasuredWordCacheEntry CLAY__MEASURED_WORD_CACHE_ENTRY_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__MeasuredWordCacheEntry NAME=Clay__MeasuredWordCacheEntryArray DEFAULT_VALUE=&CLAY__MEASURED_WORD_CACHE_ENTRY_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__MeasuredWordCacheEntryArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__MeasuredWordCacheEntry *internalArray;
+});
+Clay__MeasuredWordCacheEntryArray Clay__MeasuredWordCacheEntryArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__MeasuredWordCacheEntryArray){.capacity = capacity, .length = 0, .internalArray = (Clay__MeasuredWordCacheEntry *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__MeasuredWordCacheEntry), CLAY__ALIGNMENT(Clay__MeasuredWordCacheEntry), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
 // __GENERATED__ template array_define,array_allocate,array_get_value,array_add_value,array_set,array_remove_swapback TYPE=int32_t NAME=Clay__int32_tArray DEFAULT_VALUE=-1
 #pragma region generated
 CLAY__TYPEDEF(Clay__int32_tArray, struct
@@ -1322,6 +1783,63 @@ int32_t Clay__int32_tArray_RemoveSwapback(Clay__int32_tArray *array, int index)
 #pragma endregion
 // __GENERATED__ template
 
+// __GENERATED__ template array_define,array_allocate,array_add_value TYPE=float NAME=Clay__floatArray DEFAULT_VALUE=0
+#pragma region generated
+CLAY__TYPEDEF(Clay__floatArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	float *internalArray;
+});
+Clay__floatArray Clay__floatArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__floatArray){.capacity = capacity, .length = 0, .internalArray = (float *)Clay__Array_Allocate_Arena(capacity, sizeof(float), CLAY__ALIGNMENT(float), arena)};
+}
+void Clay__floatArray_Add(Clay__floatArray *array, float item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+	}
+}
+#pragma endregion
+// __GENERATED__ template
+
+// __GENERATED__ template array_define,array_allocate TYPE=uint8_t NAME=Clay__uint8_tArray DEFAULT_VALUE=0
+#pragma region generated
+CLAY__TYPEDEF(Clay__uint8_tArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	uint8_t *internalArray;
+});
+Clay__uint8_tArray Clay__uint8_tArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__uint8_tArray){.capacity = capacity, .length = 0, .internalArray = (uint8_t *)Clay__Array_Allocate_Arena(capacity, sizeof(uint8_t), CLAY__ALIGNMENT(uint8_t), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
+CLAY__TYPEDEF(Clay__LayoutElementAxisFlags, enum {
+    CLAY__LAYOUT_ELEMENT_AXIS_FLAG_HAS_CHILDREN = 1, // Not a text element, and has at least one child
+    CLAY__LAYOUT_ELEMENT_AXIS_FLAG_RESIZABLE = 2, // Can be grown or compressed by its parent
+    CLAY__LAYOUT_ELEMENT_AXIS_FLAG_IMAGE = 4,
+    CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLL_CONTAINER = 8,
+    CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLLS_ALONG_AXIS = 16,
+    CLAY__LAYOUT_ELEMENT_AXIS_FLAG_LAYOUT_ALONG_AXIS = 32, // Children are placed one after another along the axis
+});
+
+// The fields that Clay__SizeContainersAlongAxis reads for one axis, kept in parallel arrays indexed by layout element.
+// The sizing passes then read a few floats per child instead of loading each Clay_LayoutElement and its layoutConfig.
+CLAY__TYPEDEF(Clay__LayoutElementAxisData, struct {
+    Clay__floatArray sizes; // Working copy of the size along the axis, written back to dimensions once the parent is sized
+    Clay__floatArray minSizes;
+    Clay__floatArray sizingMins; // Holds the percentage for CLAY__SIZING_TYPE_PERCENT
+    Clay__floatArray sizingMaxes;
+    Clay__floatArray paddings;
+    Clay__floatArray childGaps;
+    Clay__uint8_tArray sizingTypes;
+    Clay__uint8_tArray flags;
+    Clay__int32_tArray firstChildOffsets; // Offset of the first child in layoutElementChildren
+    Clay__int32_tArray childCounts;
+});
+
 CLAY__TYPEDEF(Clay__LayoutElementTreeNode, struct {
     Clay_LayoutElement *layoutElement;
     Clay_Vector2 position;
@@ -1360,6 +1878,10 @@ CLAY__TYPEDEF(Clay__LayoutElementTreeRoot, struct {
     uint32_t clipElementId; // This can be zero if there is no clip element
     uint32_t zIndex;
     Clay_Vector2 pointerOffset; // Only used when scroll containers are managed externally
+    uint32_t hitTestNodeIndex;
+    uint32_t renderCommandStartIndex; // The root's render commands are contiguous, and are moved along with it when the roots are sorted
+    uint32_t elementCount; // Number of elements in this root's tree, set before the tree roots are sized in parallel
+    uint32_t scratchOffset; // Start of this root's slice of the sizing scratch buffers when sized in parallel
 });
 
 Clay__LayoutElementTreeRoot CLAY__LAYOUT_ELEMENT_TREE_ROOT_DEFAULT = {0};
@@ -1388,6 +1910,39 @@ Clay__LayoutElementTreeRoot *Clay__LayoutElementTreeRootArray_Get(Clay__LayoutEl
 #pragma endregion
 // __GENERATED__ template
 
+// A flat bounding volume hierarchy used for pointer hit testing. Nodes are stored in the same depth first order that elements
+// are positioned in, so the hierarchy can be walked as an array, skipping over any subtree whose bounds don't contain the pointer.
+// The bounding box of the element itself is read from its hash map slot, which keeps each node small.
+CLAY__TYPEDEF(Clay__HitTestNode, struct {
+    Clay_Vector2 subtreeMin; // Already offset by the root's pointerOffset
+    Clay_Vector2 subtreeMax;
+    uint32_t hashMapSlotIndex; // UINT32_MAX if the element isn't in the hash map
+    uint32_t subtreeEndIndex; // The index of the first node after this node's descendants
+});
+
+Clay__HitTestNode CLAY__HIT_TEST_NODE_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay__HitTestNode NAME=Clay__HitTestNodeArray DEFAULT_VALUE=&CLAY__HIT_TEST_NODE_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__HitTestNodeArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__HitTestNode *internalArray;
+});
+Clay__HitTestNodeArray Clay__HitTestNodeArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__HitTestNodeArray){.capacity = capacity, .length = 0, .internalArray = (Clay__HitTestNode *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__HitTestNode), CLAY__ALIGNMENT(Clay__HitTestNode), arena)};
+}
+Clay__HitTestNode *Clay__HitTestNodeArray_Add(Clay__HitTestNodeArray *array, Clay__HitTestNode item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__HIT_TEST_NODE_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
 // __GENERATED__ template array_define,array_allocate TYPE=uint8_t NAME=Clay__CharArray DEFAULT_VALUE=0
 #pragma region generated
 CLAY__TYPEDEF(Clay__CharArray, struct
@@ -1402,6 +1957,86 @@ Clay__CharArray Clay__CharArray_Allocate_Arena(uint32_t capacity, Clay_Arena *ar
 #pragma endregion
 // __GENERATED__ template
 
+// The parts of a render command that are kept for Clay_EndLayoutDiff. Configs and text don't outlive the frame, so only a hash of their contents is kept.
+CLAY__TYPEDEF(Clay__RenderCommandDiffItem, struct {
+    Clay_BoundingBox boundingBox;
+    uint32_t id;
+    Clay_RenderCommandType commandType;
+    uint32_t contentHash;
+});
+
+Clay__RenderCommandDiffItem CLAY__RENDER_COMMAND_DIFF_ITEM_DEFAULT = {0};
+
+// __GENERATED__ template array_define,array_allocate,array_add TYPE=Clay__RenderCommandDiffItem NAME=Clay__RenderCommandDiffItemArray DEFAULT_VALUE=&CLAY__RENDER_COMMAND_DIFF_ITEM_DEFAULT
+#pragma region generated
+CLAY__TYPEDEF(Clay__RenderCommandDiffItemArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__RenderCommandDiffItem *internalArray;
+});
+Clay__RenderCommandDiffItemArray Clay__RenderCommandDiffItemArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__RenderCommandDiffItemArray){.capacity = capacity, .length = 0, .internalArray = (Clay__RenderCommandDiffItem *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__RenderCommandDiffItem), CLAY__ALIGNMENT(Clay__RenderCommandDiffItem), arena)};
+}
+Clay__RenderCommandDiffItem *Clay__RenderCommandDiffItemArray_Add(Clay__RenderCommandDiffItemArray *array, Clay__RenderCommandDiffItem item) {
+	if (Clay__Array_AddCapacityCheck(array->length, array->capacity)) {
+		array->internalArray[array->length++] = item;
+		return &array->internalArray[array->length - 1];
+	}
+	return &CLAY__RENDER_COMMAND_DIFF_ITEM_DEFAULT;
+}
+#pragma endregion
+// __GENERATED__ template
+
+// Open addressing hash map slot, chaining together the previous frame's commands that share an id and type
+CLAY__TYPEDEF(Clay__RenderCommandDiffSlot, struct {
+    uint32_t id;
+    Clay_RenderCommandType commandType;
+    int32_t nextMatchIndex;
+    int32_t lastIndex; // -1 when the slot is empty
+});
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__RenderCommandDiffSlot NAME=Clay__RenderCommandDiffSlotArray
+#pragma region generated
+CLAY__TYPEDEF(Clay__RenderCommandDiffSlotArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__RenderCommandDiffSlot *internalArray;
+});
+Clay__RenderCommandDiffSlotArray Clay__RenderCommandDiffSlotArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__RenderCommandDiffSlotArray){.capacity = capacity, .length = 0, .internalArray = (Clay__RenderCommandDiffSlot *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__RenderCommandDiffSlot), CLAY__ALIGNMENT(Clay__RenderCommandDiffSlot), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
+CLAY__TYPEDEF(Clay__RenderCommandDiffStatus, enum {
+    CLAY__RENDER_COMMAND_DIFF_STATUS_UNCHANGED,
+    CLAY__RENDER_COMMAND_DIFF_STATUS_ADDED,
+    CLAY__RENDER_COMMAND_DIFF_STATUS_MOVED,
+    CLAY__RENDER_COMMAND_DIFF_STATUS_CHANGED,
+});
+
+// A render command's position in the batched order, see Clay_SetRenderCommandBatchingEnabled
+CLAY__TYPEDEF(Clay__RenderCommandBatchItem, struct {
+    uint64_t sortKey; // The layer in the top 24 bits, then the command type and a hash of its font or image
+    uint32_t index;
+});
+
+// __GENERATED__ template array_define,array_allocate TYPE=Clay__RenderCommandBatchItem NAME=Clay__RenderCommandBatchItemArray
+#pragma region generated
+CLAY__TYPEDEF(Clay__RenderCommandBatchItemArray, struct
+{
+	uint32_t capacity;
+	uint32_t length;
+	Clay__RenderCommandBatchItem *internalArray;
+});
+Clay__RenderCommandBatchItemArray Clay__RenderCommandBatchItemArray_Allocate_Arena(uint32_t capacity, Clay_Arena *arena) {
+    return CLAY__INIT(Clay__RenderCommandBatchItemArray){.capacity = capacity, .length = 0, .internalArray = (Clay__RenderCommandBatchItem *)Clay__Array_Allocate_Arena(capacity, sizeof(Clay__RenderCommandBatchItem), CLAY__ALIGNMENT(Clay__RenderCommandBatchItem), arena)};
+}
+#pragma endregion
+// __GENERATED__ template
+
 Clay_String Clay__WriteStringToCharBuffer(Clay__CharArray *buffer, Clay_String string) {
     for (size_t i = 0; i < string.length; i++) {
         buffer->internalArray[buffer->length + i] = string.chars[i];
@@ -1411,58 +2046,195 @@ Clay_String Clay__WriteStringToCharBuffer(Clay__CharArray *buffer, Clay_String s
 }
 
 // Global Variable Definitions ----------------------------------------------
-Clay_PointerData Clay__pointerInfo = { .position = {-1, -1} };
-Clay_Dimensions Clay__layoutDimensions = {0};
-Clay_ElementId Clay__dynamicElementIndexBaseHash = { .id = 128476991, .stringId = { .length = 8, .chars = "Auto ID" } };
-uint32_t Clay__dynamicElementIndex = 0;
-bool Clay__debugModeEnabled = false;
-bool Clay__disableCulling = false;
-bool Clay__externalScrollHandlingEnabled = false;
-uint32_t Clay__debugSelectedElementId = 0;
 uint32_t Clay__debugViewWidth = 400;
 Clay_Color Clay__debugViewHighlightColor = { 168, 66, 28, 100 };
-uint32_t Clay__generation = 0;
-uint64_t Clay__arenaResetOffset = 0;
-Clay_Arena Clay__internalArena;
-// Layout Elements / Render Commands
-Clay_LayoutElementArray Clay__layoutElements;
-Clay_RenderCommandArray Clay__renderCommands;
-Clay__int32_tArray Clay__openLayoutElementStack;
-Clay__int32_tArray Clay__layoutElementChildren;
-Clay__int32_tArray Clay__layoutElementChildrenBuffer;
-Clay__TextElementDataArray Clay__textElementData;
-Clay__LayoutElementPointerArray Clay__imageElementPointers;
-Clay__int32_tArray Clay__reusableElementIndexBuffer;
-Clay__int32_tArray Clay__layoutElementClipElementIds;
-// Configs
-Clay__LayoutConfigArray Clay__layoutConfigs;
-Clay__ElementConfigArray Clay__elementConfigBuffer;
-Clay__ElementConfigArray Clay__elementConfigs;
-Clay__RectangleElementConfigArray Clay__rectangleElementConfigs;
-Clay__TextElementConfigArray Clay__textElementConfigs;
-Clay__ImageElementConfigArray Clay__imageElementConfigs;
-Clay__FloatingElementConfigArray Clay__floatingElementConfigs;
-Clay__ScrollElementConfigArray Clay__scrollElementConfigs;
-Clay__CustomElementConfigArray Clay__customElementConfigs;
-Clay__BorderElementConfigArray Clay__borderElementConfigs;
-// Misc Data Structures
-Clay__StringArray Clay__layoutElementIdStrings;
-Clay__WrappedTextLineArray Clay__wrappedTextLines;
-Clay__LayoutElementTreeNodeArray Clay__layoutElementTreeNodeArray1;
-Clay__LayoutElementTreeRootArray Clay__layoutElementTreeRoots;
-Clay__LayoutElementHashMapItemArray Clay__layoutElementsHashMapInternal;
-Clay__int32_tArray Clay__layoutElementsHashMap;
-Clay__MeasureTextCacheItemArray Clay__measureTextHashMapInternal;
-Clay__int32_tArray Clay__measureTextHashMapInternalFreeList;
-Clay__int32_tArray Clay__measureTextHashMap;
-Clay__MeasuredWordArray Clay__measuredWords;
-Clay__int32_tArray Clay__measuredWordsFreeList;
-Clay__int32_tArray Clay__openClipElementStack;
-Clay__ElementIdArray Clay__pointerOverIds;
-Clay__ScrollContainerDataInternalArray Clay__scrollContainerDatas;
-Clay__BoolArray Clay__treeNodeVisited;
-Clay__CharArray Clay__dynamicStringData;
-Clay__DebugElementDataArray Clay__debugElementData;
+
+// All per-instance state lives here, so that multiple independent layouts can be run (including on different threads).
+struct Clay_Context {
+    uint32_t maxElementCount;
+    uint32_t maxMeasureTextCacheWordCount;
+    uint32_t maxScrollContainerCount;
+    uint32_t maxTextElementCount;
+    uint32_t maxImageElementCount;
+    uint32_t maxFloatingElementCount;
+    uint32_t maxBorderElementCount;
+    uint32_t maxCustomElementCount;
+    uint32_t maxPersistedConfigCount;
+    bool warningsEnabled;
+    Clay_ErrorHandler errorHandler;
+    Clay_BooleanWarnings booleanWarnings;
+    Clay__WarningArray warnings;
+
+    Clay_PointerData pointerInfo;
+    Clay_Dimensions layoutDimensions;
+    Clay_ElementId dynamicElementIndexBaseHash;
+    uint32_t dynamicElementIndex;
+    bool debugModeEnabled;
+    bool disableCulling;
+    bool externalScrollHandlingEnabled;
+    bool incrementalLayoutEnabled;
+    bool textContentHashingEnabled;
+    bool wrappedTextCachingEnabled;
+    bool renderCommandBatchingEnabled;
+    bool frameUnchanged;
+    bool scrollAnimationActive;
+    uint32_t frameHash;
+    uint32_t debugSelectedElementId;
+    uint32_t generation;
+    uint64_t arenaResetOffset;
+    Clay_Arena internalArena;
+    // Layout Elements / Render Commands
+    Clay_LayoutElementArray layoutElements;
+    Clay_RenderCommandArray renderCommands;
+    Clay__int32_tArray openLayoutElementStack;
+    Clay__int32_tArray layoutElementChildren;
+    Clay__int32_tArray layoutElementChildrenBuffer;
+    Clay__TextElementDataArray textElementData;
+    Clay__LayoutElementPointerArray imageElementPointers;
+    Clay__int32_tArray reusableElementIndexBuffer;
+    Clay__int32_tArray layoutElementClipElementIds;
+    // Configs
+    Clay__LayoutConfigArray layoutConfigs;
+    Clay__ElementConfigArray elementConfigBuffer;
+    Clay__ElementConfigArray elementConfigs;
+    Clay__RectangleElementConfigArray rectangleElementConfigs;
+    Clay__TextElementConfigArray textElementConfigs;
+    Clay__ImageElementConfigArray imageElementConfigs;
+    Clay__FloatingElementConfigArray floatingElementConfigs;
+    Clay__ScrollElementConfigArray scrollElementConfigs;
+    Clay__CustomElementConfigArray customElementConfigs;
+    Clay__BorderElementConfigArray borderElementConfigs;
+    Clay__ConfigInternSlotArray configInternTable;
+    Clay__PersistedConfigArray persistedConfigs;
+    Clay__int32_tArray persistedConfigIndices; // Open addressed by config hash, -1 for an empty slot
+    // Misc Data Structures
+    Clay__StringArray layoutElementIdStrings;
+    Clay__WrappedTextLineArray wrappedTextLines;
+    Clay__LayoutElementTreeNodeArray layoutElementTreeNodeArray1;
+    Clay__LayoutElementTreeRootArray layoutElementTreeRoots;
+    Clay__HitTestNodeArray hitTestNodes;
+    Clay__LayoutElementHashMapItemArray layoutElementsHashMapInternal;
+    Clay__LayoutElementHashMapSlotArray layoutElementsHashMap;
+    Clay__MeasureTextCacheItemArray measureTextHashMapInternal;
+    Clay__int32_tArray measureTextHashMapInternalFreeList;
+    Clay__int32_tArray measureTextHashMap;
+    Clay__MeasuredWordArray measuredWords;
+    Clay__int32_tArray measuredWordOwners; // The cache item whose words start at each index, or -1
+    uint32_t measuredWordsEvictedCount; // Words belonging to evicted cache items, which compacting would reclaim
+    Clay__MeasuredWordCacheEntryArray measuredWordCache; // Open addressed by word id
+    uint32_t measuredWordCacheCount;
+    Clay__MeasureTextBatchItemArray measureTextBatchItems;
+    Clay__MeasureTextBatchTargetArray measureTextBatchTargets;
+    Clay__MeasureTextBatchSlotArray measureTextBatchSlots;
+    Clay__DimensionsArray measureTextBatchDimensions;
+    float measureTextBatchSpaceWidth;
+    Clay__GlyphAdvanceTableEntryArray glyphAdvanceTables;
+    bool measureTextBatchPending; // Text elements were declared with placeholder sizes this frame
+    Clay__int32_tArray openClipElementStack;
+    Clay__floatArray sizeDistributionBuffer;
+    Clay__LayoutElementAxisData layoutElementAxisData;
+    Clay_BoundingBoxArray cullingRectangles; // The visible region of each scroll container on the path to the current element during positioning
+    Clay__ElementIdArray pointerOverIds;
+    Clay__ScrollContainerDataInternalArray scrollContainerDatas;
+    Clay__int32_tArray scrollContainerDataIndices; // Open addressed by element id, -1 for an empty slot
+    Clay__BoolArray treeNodeVisited;
+    Clay__CharArray dynamicStringData;
+    Clay__DebugElementDataArray debugElementData;
+    Clay__LayoutCacheDataArray layoutCaches;
+    Clay__CachedTextLineArray cachedTextLines;
+    Clay__CachedTextLineArray previousCachedTextLines;
+    Clay__WrappedLinesCacheEntryArray wrappedLinesCacheEntries;
+    Clay__CachedTextLineArray wrappedLineCache;
+    Clay__CachedTextLineArray previousWrappedLineCache;
+    Clay__RenderCommandDiffItemArray renderCommandDiffItems;
+    Clay__RenderCommandDiffItemArray previousRenderCommandDiffItems;
+    Clay__RenderCommandDiffSlotArray renderCommandDiffSlots;
+    Clay__int32_tArray renderCommandDiffNextIndices;
+    Clay__int32_tArray renderCommandDiffStatuses;
+    Clay_RenderCommandArray renderCommandDiffs;
+    Clay_Dimensions renderCommandDiffLayoutDimensions;
+    Clay_BoundingBoxArray damageRectangles;
+    Clay__RenderCommandBatchItemArray renderCommandBatchItems;
+    Clay__RenderCommandBatchItemArray renderCommandBatchScratch;
+};
+
+#ifndef __cplusplus
+CLAY__ALIGNMENT_STRUCT(Clay_Context);
+#endif
+
+CLAY__THREAD_LOCAL Clay_Context *Clay__currentContext = CLAY__NULL;
+
+CLAY_WASM_EXPORT("Clay_GetCurrentContext")
+Clay_Context* Clay_GetCurrentContext(void) {
+    return Clay__currentContext;
+}
+
+CLAY_WASM_EXPORT("Clay_SetCurrentContext")
+void Clay_SetCurrentContext(Clay_Context* context) {
+    Clay__currentContext = context;
+}
+
+void* Clay__Array_Allocate_Arena(uint32_t capacity, uint32_t itemSize, uint32_t alignment, Clay_Arena *arena)
+{
+    size_t totalSizeBytes = capacity * itemSize;
+    uintptr_t nextAllocAddress = arena->nextAllocation + (uintptr_t)arena->memory;
+    uintptr_t arenaOffsetAligned = nextAllocAddress + (alignment - (nextAllocAddress % alignment));
+    arenaOffsetAligned -= (uintptr_t)arena->memory;
+    if (arenaOffsetAligned + totalSizeBytes <= arena->capacity) {
+        arena->nextAllocation = arenaOffsetAligned + totalSizeBytes;
+        return (void*)((uintptr_t)arena->memory + (uintptr_t)arenaOffsetAligned);
+    }
+    else {
+        // No context is current while Clay_CreateContext allocates the context itself, which reports the error on its own
+        Clay_Context* context = Clay_GetCurrentContext();
+        Clay_ErrorHandler errorHandler = context ? context->errorHandler : CLAY__INIT(Clay_ErrorHandler) { .errorHandlerFunction = Clay__ErrorHandlerFunctionDefault };
+        errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay attempted to allocate memory in its arena, but ran out of capacity. Try increasing the capacity of the arena passed to Clay_Initialize()"),
+                .userData = errorHandler.userData });
+    }
+    return CLAY__NULL;
+}
+
+bool Clay__Array_RangeCheck(int index, uint32_t length)
+{
+    if (index < length && index >= 0) {
+        return true;
+    }
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_INTERNAL_ERROR,
+            .errorText = CLAY_STRING("Clay attempted to make an out of bounds array access. This is an internal error and is likely a bug."),
+            .userData = context->errorHandler.userData });
+    return false;
+}
+
+bool Clay__Array_AddCapacityCheck(uint32_t length, uint32_t capacity)
+{
+    if (length < capacity) {
+        return true;
+    }
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+        .errorType = CLAY_ERROR_TYPE_INTERNAL_ERROR,
+        .errorText = CLAY_STRING("Clay attempted to make an out of bounds array access. This is an internal error and is likely a bug."),
+        .userData = context->errorHandler.userData });
+    return false;
+}
+
+// Like Clay__Array_AddCapacityCheck, but for arrays sized by one of the per category capacities, which user code can run out of
+bool Clay__ElementCategoryCapacityCheck(uint32_t length, uint32_t capacity, Clay_String errorText)
+{
+    if (length < capacity) {
+        return true;
+    }
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+        .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+        .errorText = errorText,
+        .userData = context->errorHandler.userData });
+    return false;
+}
 
 #ifdef CLAY_WASM
     __attribute__((import_module("clay"), import_name("measureTextFunction"))) Clay_Dimensions Clay__MeasureText(Clay_String *text, Clay_TextElementConfig *config);
@@ -1471,9 +2243,21 @@ Clay__DebugElementDataArray Clay__debugElementData;
     Clay_Dimensions (*Clay__MeasureText)(Clay_String *text, Clay_TextElementConfig *config);
     Clay_Vector2 (*Clay__QueryScrollOffset)(uint32_t elementId);
 #endif
+void (*Clay__MeasureTextBatch)(Clay_MeasureTextBatchItem *items, uint32_t itemCount, Clay_Dimensions *dimensions);
+void (*Clay__ParallelFor)(uint32_t jobCount, void (*job)(uint32_t jobIndex, void *jobData), void *jobData);
 
 Clay_LayoutElement* Clay__GetOpenLayoutElement(void) {
-    return Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&Clay__openLayoutElementStack, Clay__openLayoutElementStack.length - 1));
+    Clay_Context* context = Clay_GetCurrentContext();
+    return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_Get(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1));
+}
+
+uint32_t Clay__GetOpenLayoutElementId(void) {
+    return Clay__GetOpenLayoutElement()->id;
+}
+
+uint32_t Clay__GetParentElementChildCount(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_Get(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2))->childrenOrTextContent.children.length;
 }
 
 bool Clay__ElementHasConfig(Clay_LayoutElement *element, Clay__ElementConfigType type) {
@@ -1548,13 +2332,52 @@ uint32_t Clay__RehashWithNumber(uint32_t id, uint32_t number) {
     return id;
 }
 
+uint32_t Clay__HashLayoutValue(uint32_t hash, uint32_t value) {
+    hash += value;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+    return hash;
+}
+
+uint32_t Clay__HashBytes(uint32_t hash, const uint8_t *bytes, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash = Clay__HashLayoutValue(hash, bytes[i]);
+    }
+    return hash;
+}
+
+// Members added with CLAY_EXTEND_CONFIG_* follow the last built in member, and are hashed as raw bytes since their layout isn't known
+#define CLAY__HASH_CONFIG_EXTENSION(hash, config, type, lastMember) Clay__HashBytes(hash, (const uint8_t *)(config) + offsetof(type, lastMember) + sizeof((config)->lastMember), sizeof(type) - offsetof(type, lastMember) - sizeof((config)->lastMember))
+
+// Hashes four bytes per step rather than one, which is enough to keep hashing cheaper than re-measuring the text
+uint32_t Clay__HashTextContent(uint32_t hash, Clay_String *text) {
+    const uint8_t *chars = (const uint8_t *)text->chars;
+    size_t i = 0;
+    for (; i + 4 <= text->length; i += 4) {
+        hash += (uint32_t)chars[i] | ((uint32_t)chars[i + 1] << 8) | ((uint32_t)chars[i + 2] << 16) | ((uint32_t)chars[i + 3] << 24);
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    for (; i < text->length; ++i) {
+        hash += chars[i];
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    return hash;
+}
+
 uint32_t Clay__HashTextWithConfig(Clay_String *text, Clay_TextElementConfig *config) {
+    Clay_Context* context = Clay_GetCurrentContext();
     uint32_t hash = 0;
-    uintptr_t pointerAsNumber = (uintptr_t)text->chars;
+    if (context->textContentHashingEnabled) {
+        hash = Clay__HashTextContent(hash, text);
+    } else {
+        uintptr_t pointerAsNumber = (uintptr_t)text->chars;
 
-    hash += pointerAsNumber;
-    hash += (hash << 10);
-    hash ^= (hash >> 6);
+        hash += pointerAsNumber;
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
 
     hash += text->length;
     hash += (hash << 10);
@@ -1580,148 +2403,495 @@ uint32_t Clay__HashTextWithConfig(Clay_String *text, Clay_TextElementConfig *con
     hash += (hash << 10);
     hash ^= (hash >> 6);
 
+    #ifdef CLAY_EXTEND_CONFIG_TEXT
+    hash = CLAY__HASH_CONFIG_EXTENSION(hash, config, Clay_TextElementConfig, wrapMode);
+    #endif
+
     hash += (hash << 3);
     hash ^= (hash >> 11);
     hash += (hash << 15);
     return hash + 1; // Reserve the hash result of zero as "null id"
 }
 
-Clay__MeasuredWord *Clay__AddMeasuredWord(Clay__MeasuredWord word, Clay__MeasuredWord *previousWord) {
-    if (Clay__measuredWordsFreeList.length > 0) {
-        uint32_t newItemIndex = Clay__int32_tArray_Get(&Clay__measuredWordsFreeList, (int)Clay__measuredWordsFreeList.length - 1);
-        Clay__measuredWordsFreeList.length--;
-        Clay__MeasuredWordArray_Set(&Clay__measuredWords, (int)newItemIndex, word);
-        previousWord->next = (int32_t)newItemIndex;
-        return Clay__MeasuredWordArray_Get(&Clay__measuredWords, (int)newItemIndex);
-    } else {
-        previousWord->next = (int32_t)Clay__measuredWords.length;
-        return Clay__MeasuredWordArray_Add(&Clay__measuredWords, word);
+// Fills in the running widths used to find line breaks with a binary search, rather than adding up words one at a time
+void Clay__UpdateMeasuredWordsWidthBefore(Clay__MeasureTextCacheItem *cacheItem) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (cacheItem->measuredWordsCount == 0) {
+        return;
     }
-}
-
-Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_TextElementConfig *config) {
-    #ifndef CLAY_WASM
-    if (!Clay__MeasureText) {
-        Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-            .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_FUNCTION_NOT_PROVIDED,
-            .errorText = CLAY_STRING("Clay's internal MeasureText function is null. You may have forgotten to call Clay_SetMeasureTextFunction(), or passed a NULL function pointer by mistake."),
-            .userData = Clay__errorHandler.userData });
-        return NULL;
+    Clay__MeasuredWord *words = &context->measuredWords.internalArray[cacheItem->measuredWordsStartIndex];
+    float widthBefore = 0;
+    for (uint32_t i = 0; i < cacheItem->measuredWordsCount; ++i) {
+        words[i].widthBefore = widthBefore;
+        // measuredWord->length == 0 means a newline character
+        widthBefore = words[i].length == 0 ? 0 : widthBefore + words[i].width;
     }
-    #endif
-    uint32_t id = Clay__HashTextWithConfig(text, config);
-    uint32_t hashBucket = id % (Clay__maxMeasureTextCacheWordCount / 32);
-    int32_t elementIndexPrevious = 0;
-    int32_t elementIndex = Clay__measureTextHashMap.internalArray[hashBucket];
-    while (elementIndex != 0) {
-        Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&Clay__measureTextHashMapInternal, elementIndex);
-        if (hashEntry->id == id) {
-            hashEntry->generation = Clay__generation;
-            return hashEntry;
+    uint32_t lineBreakIndex = cacheItem->measuredWordsCount;
+    for (uint32_t i = cacheItem->measuredWordsCount; i > 0; --i) {
+        if (words[i - 1].length == 0) {
+            lineBreakIndex = i - 1;
         }
-        // This element hasn't been seen in a few frames, delete the hash map item
-        if (Clay__generation - hashEntry->generation > 2) {
-            // Add all the measured words that were included in this measurement to the freelist
-            int32_t nextWordIndex = hashEntry->measuredWordsStartIndex;
-            while (nextWordIndex != -1) {
-                Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&Clay__measuredWords, nextWordIndex);
-                Clay__int32_tArray_Add(&Clay__measuredWordsFreeList, nextWordIndex);
-                nextWordIndex = measuredWord->next;
-            }
+        words[i - 1].lineBreakIndex = lineBreakIndex;
+    }
+}
 
-            uint32_t nextIndex = hashEntry->nextIndex;
-            Clay__MeasureTextCacheItemArray_Set(&Clay__measureTextHashMapInternal, elementIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1 });
-            Clay__int32_tArray_Add(&Clay__measureTextHashMapInternalFreeList, elementIndex);
-            if (elementIndexPrevious == 0) {
-                Clay__measureTextHashMap.internalArray[hashBucket] = nextIndex;
-            } else {
-                Clay__MeasureTextCacheItem *previousHashEntry = Clay__MeasureTextCacheItemArray_Get(&Clay__measureTextHashMapInternal, elementIndexPrevious);
-                previousHashEntry->nextIndex = nextIndex;
-            }
-            elementIndex = nextIndex;
-        } else {
-            elementIndexPrevious = elementIndex;
-            elementIndex = hashEntry->nextIndex;
+void Clay__FlushMeasureTextBatch(void);
+
+// Moves the words of every cache item that is still alive to the start of the array, reclaiming the space left by evicted items
+void Clay__CompactMeasuredWords(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    // Queued measurements refer to words by index, so they are resolved before anything moves
+    Clay__FlushMeasureTextBatch();
+    uint32_t writeIndex = 0;
+    uint32_t readIndex = 0;
+    while (readIndex < context->measuredWords.length) {
+        int32_t owner = context->measuredWordOwners.internalArray[readIndex];
+        if (owner == -1) {
+            readIndex++;
+            continue;
+        }
+        Clay__MeasureTextCacheItem *cacheItem = &context->measureTextHashMapInternal.internalArray[owner];
+        for (uint32_t i = 0; i < cacheItem->measuredWordsCount; ++i) {
+            context->measuredWords.internalArray[writeIndex + i] = context->measuredWords.internalArray[readIndex + i];
         }
+        context->measuredWordOwners.internalArray[readIndex] = -1;
+        context->measuredWordOwners.internalArray[writeIndex] = owner;
+        cacheItem->measuredWordsStartIndex = (int32_t)writeIndex;
+        writeIndex += cacheItem->measuredWordsCount;
+        readIndex += cacheItem->measuredWordsCount;
     }
+    context->measuredWords.length = writeIndex;
+    context->measuredWordsEvictedCount = 0;
+}
 
-    uint32_t newItemIndex = 0;
-    Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .id = id, .generation = Clay__generation };
-    Clay__MeasureTextCacheItem *measured = NULL;
-    if (Clay__measureTextHashMapInternalFreeList.length > 0) {
-        newItemIndex = Clay__int32_tArray_Get(&Clay__measureTextHashMapInternalFreeList, Clay__measureTextHashMapInternalFreeList.length - 1);
-        Clay__measureTextHashMapInternalFreeList.length--;
-        Clay__MeasureTextCacheItemArray_Set(&Clay__measureTextHashMapInternal, newItemIndex, newCacheItem);
-        measured = Clay__MeasureTextCacheItemArray_Get(&Clay__measureTextHashMapInternal, newItemIndex);
-    } else {
-        if (Clay__measureTextHashMapInternal.length == Clay__measureTextHashMapInternal.capacity - 1) {
-            if (Clay__booleanWarnings.maxTextMeasureCacheExceeded) {
-                Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                        .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
-                        .errorText = CLAY_STRING("Clay ran out of capacity while attempting to measure text elements. Try using Clay_SetMaxElementCount() with a higher value."),
-                        .userData = Clay__errorHandler.userData });
-                Clay__booleanWarnings.maxTextMeasureCacheExceeded = true;
-            }
-            return &CLAY__MEASURE_TEXT_CACHE_ITEM_DEFAULT;
+// The words of each cache item are stored contiguously. Space is taken from the end of the array, and the array is
+// compacted once it fills up. Returns -1 if there isn't enough space even after compacting.
+int32_t Clay__AllocateMeasuredWords(uint32_t count) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->measuredWords.length + count > context->measuredWords.capacity) {
+        if (context->measuredWords.length - context->measuredWordsEvictedCount + count > context->measuredWords.capacity) {
+            return -1;
         }
-        measured = Clay__MeasureTextCacheItemArray_Add(&Clay__measureTextHashMapInternal, newCacheItem);
-        newItemIndex = Clay__measureTextHashMapInternal.length - 1;
+        Clay__CompactMeasuredWords();
     }
+    int32_t startIndex = (int32_t)context->measuredWords.length;
+    context->measuredWords.length += count;
+    return startIndex;
+}
 
-    uint32_t start = 0;
-    uint32_t end = 0;
-    float measuredWidth = 0;
-    float measuredHeight = 0;
-    float spaceWidth = Clay__MeasureText(&CLAY__SPACECHAR, config).width;
-    Clay__MeasuredWord tempWord = { .next = -1 };
-    Clay__MeasuredWord *previousWord = &tempWord;
-    while (end < text->length) {
-        if (Clay__measuredWords.length == Clay__measuredWords.capacity - 1) {
-            if (!Clay__booleanWarnings.maxTextMeasureCacheExceeded) {
-                Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
-                    .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
-                    .userData = Clay__errorHandler.userData });
-                Clay__booleanWarnings.maxTextMeasureCacheExceeded = true;
-            }
-            return &CLAY__MEASURE_TEXT_CACHE_ITEM_DEFAULT;
-        }
-        char current = text->chars[end];
-        if (current == ' ' || current == '\n') {
-            uint32_t length = end - start;
+// FNV-1a, which shares nothing with the hash used for the id, so a collision in one is very unlikely to be one in the other
+uint32_t Clay__HashWordCheck(uint32_t hash, const uint8_t *bytes, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+Clay__MeasuredWordKey Clay__HashWordWithConfig(Clay_String *word, Clay_TextElementConfig *config) {
+    uint32_t hash = Clay__HashTextContent(0, word);
+
+    hash += word->length;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+
+    hash += config->fontId;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+
+    hash += config->fontSize;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+
+    hash += config->letterSpacing;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+
+    #ifdef CLAY_EXTEND_CONFIG_TEXT
+    hash = CLAY__HASH_CONFIG_EXTENSION(hash, config, Clay_TextElementConfig, wrapMode);
+    #endif
+
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+
+    uint16_t fontSettings[3] = { config->fontId, config->fontSize, config->letterSpacing };
+    uint32_t checkHash = Clay__HashWordCheck(2166136261u, (const uint8_t *)word->chars, word->length);
+    checkHash = Clay__HashWordCheck(checkHash, (const uint8_t *)fontSettings, sizeof(fontSettings));
+    #ifdef CLAY_EXTEND_CONFIG_TEXT
+    size_t extensionOffset = offsetof(Clay_TextElementConfig, wrapMode) + sizeof(config->wrapMode);
+    checkHash = Clay__HashWordCheck(checkHash, (const uint8_t *)config + extensionOffset, sizeof(Clay_TextElementConfig) - extensionOffset);
+    #endif
+    return CLAY__INIT(Clay__MeasuredWordKey) { .id = hash ? hash : 1, .length = (uint32_t)word->length, .checkHash = checkHash }; // Reserve zero for empty slots
+}
+
+bool Clay__MeasuredWordKeyEquals(Clay__MeasuredWordKey a, Clay__MeasuredWordKey b) {
+    return a.id == b.id && a.length == b.length && a.checkHash == b.checkHash;
+}
+
+void Clay__ClearMeasuredWordCache(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (uint32_t i = 0; i < context->measuredWordCache.capacity; ++i) {
+        context->measuredWordCache.internalArray[i] = CLAY__MEASURED_WORD_CACHE_ENTRY_DEFAULT;
+    }
+    context->measuredWordCacheCount = 0;
+}
+
+// Returns the entry holding the word, or the empty entry where it would be inserted
+Clay__MeasuredWordCacheEntry *Clay__FindMeasuredWordCacheEntry(Clay__MeasuredWordKey key) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasuredWordCacheEntryArray *cache = &context->measuredWordCache;
+    uint32_t entryIndex = key.id & (cache->capacity - 1);
+    while (cache->internalArray[entryIndex].key.id != 0 && !Clay__MeasuredWordKeyEquals(cache->internalArray[entryIndex].key, key)) {
+        entryIndex = (entryIndex + 1) & (cache->capacity - 1);
+    }
+    return &cache->internalArray[entryIndex];
+}
+
+void Clay__StoreMeasuredWordDimensions(Clay__MeasuredWordKey key, Clay_Dimensions dimensions) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasuredWordCacheEntry *entry = Clay__FindMeasuredWordCacheEntry(key);
+    if (entry->key.id == 0) {
+        // Words aren't evicted individually, instead the whole cache starts over once it is half full
+        if (context->measuredWordCacheCount == context->measuredWordCache.capacity / 2) {
+            Clay__ClearMeasuredWordCache();
+            entry = Clay__FindMeasuredWordCacheEntry(key);
+        }
+        entry->key = key;
+        context->measuredWordCacheCount++;
+    }
+    entry->dimensions = dimensions;
+}
+
+// Returns the dimensions of a word that was measured before, in any string, or NULL if it hasn't been
+Clay_Dimensions *Clay__FindMeasuredWordDimensions(Clay__MeasuredWordKey key) {
+    Clay__MeasuredWordCacheEntry *entry = Clay__FindMeasuredWordCacheEntry(key);
+    return entry->key.id != 0 ? &entry->dimensions : CLAY__NULL;
+}
+
+Clay_Dimensions Clay__MeasureWordCached(Clay_String *word, Clay_TextElementConfig *config) {
+    Clay__MeasuredWordKey key = Clay__HashWordWithConfig(word, config);
+    Clay_Dimensions *cachedDimensions = Clay__FindMeasuredWordDimensions(key);
+    if (cachedDimensions) {
+        return *cachedDimensions;
+    }
+    Clay_Dimensions dimensions = Clay__MeasureText(word, config);
+    Clay__StoreMeasuredWordDimensions(key, dimensions);
+    return dimensions;
+}
+
+void Clay__ClearMeasureTextBatchSlots(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (uint32_t i = 0; i < context->measureTextBatchSlots.capacity; ++i) {
+        context->measureTextBatchSlots.internalArray[i] = CLAY__INIT(Clay__MeasureTextBatchSlot) {0};
+    }
+}
+
+// Measures every queued string with a single call to the batch function, and writes the results into the words and
+// cache items they were queued for.
+void Clay__FlushMeasureTextBatch(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->measureTextBatchItems.length == 0) {
+        return;
+    }
+    Clay__MeasureTextBatch(context->measureTextBatchItems.internalArray, context->measureTextBatchItems.length, context->measureTextBatchDimensions.internalArray);
+    for (uint32_t i = 0; i < context->measureTextBatchTargets.length; ++i) {
+        Clay__MeasureTextBatchTarget *target = &context->measureTextBatchTargets.internalArray[i];
+        Clay_Dimensions dimensions = context->measureTextBatchDimensions.internalArray[target->batchItemIndex];
+        if (target->wordKey.id != 0) {
+            Clay__StoreMeasuredWordDimensions(target->wordKey, dimensions);
+        }
+        // The space is always queued before the words of its cache item, and carries over if the batch fills up in between
+        if (target->isSpaceWidth) {
+            context->measureTextBatchSpaceWidth = dimensions.width;
+            continue;
+        }
+        if (target->followedBySpace) {
+            dimensions.width += context->measureTextBatchSpaceWidth;
+        }
+        // The placeholder already holds the width of the following space if it was known when the word was queued
+        if (target->measuredWordIndex != -1) {
+            context->measuredWords.internalArray[target->measuredWordIndex].width += dimensions.width;
+        }
+        Clay__MeasureTextCacheItem *cacheItem = &context->measureTextHashMapInternal.internalArray[target->cacheItemIndex];
+        cacheItem->unwrappedDimensions.width += dimensions.width;
+        cacheItem->unwrappedDimensions.height = dimensions.height;
+    }
+    for (uint32_t i = 0; i < context->measureTextBatchTargets.length; ++i) {
+        int32_t cacheItemIndex = context->measureTextBatchTargets.internalArray[i].cacheItemIndex;
+        if (i == 0 || cacheItemIndex != context->measureTextBatchTargets.internalArray[i - 1].cacheItemIndex) {
+            Clay__UpdateMeasuredWordsWidthBefore(&context->measureTextHashMapInternal.internalArray[cacheItemIndex]);
+        }
+    }
+    context->measureTextBatchItems.length = 0;
+    context->measureTextBatchTargets.length = 0;
+    Clay__ClearMeasureTextBatchSlots();
+}
+
+// Words that are already in the batch aren't added again, the target is pointed at the existing item instead
+void Clay__QueueMeasureText(Clay_String text, Clay_TextElementConfig *config, Clay__MeasureTextBatchTarget target) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    // There are never more items than targets, so the items can't fill up first
+    if (context->measureTextBatchTargets.length == context->measureTextBatchTargets.capacity) {
+        Clay__FlushMeasureTextBatch();
+    }
+    Clay__MeasureTextBatchSlotArray *slots = &context->measureTextBatchSlots;
+    uint32_t slotIndex = target.wordKey.id & (slots->capacity - 1);
+    while (slots->internalArray[slotIndex].wordKey.id != 0 && !Clay__MeasuredWordKeyEquals(slots->internalArray[slotIndex].wordKey, target.wordKey)) {
+        slotIndex = (slotIndex + 1) & (slots->capacity - 1);
+    }
+    Clay__MeasureTextBatchSlot *slot = &slots->internalArray[slotIndex];
+    if (slot->wordKey.id == 0) {
+        slot->wordKey = target.wordKey;
+        slot->batchItemIndex = (int32_t)context->measureTextBatchItems.length;
+        Clay__MeasureTextBatchItemArray_Add(&context->measureTextBatchItems, CLAY__INIT(Clay_MeasureTextBatchItem) { .text = text, .config = config });
+    }
+    target.batchItemIndex = slot->batchItemIndex;
+    Clay__MeasureTextBatchTargetArray_Add(&context->measureTextBatchTargets, target);
+    context->measureTextBatchPending = true;
+}
+
+Clay__GlyphAdvanceTableEntry *Clay__FindGlyphAdvanceTable(Clay_TextElementConfig *config) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (uint32_t i = 0; i < context->glyphAdvanceTables.length; ++i) {
+        Clay__GlyphAdvanceTableEntry *entry = &context->glyphAdvanceTables.internalArray[i];
+        if (entry->table->fontId == config->fontId && entry->table->fontSize == config->fontSize) {
+            return entry;
+        }
+    }
+    return CLAY__NULL;
+}
+
+float Clay__FindKerningAdjustment(Clay_GlyphAdvanceTable *table, uint8_t first, uint8_t second) {
+    uint32_t key = (first << 8) | second;
+    uint32_t low = 0;
+    uint32_t high = table->kerningPairCount;
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        Clay_KerningPair *pair = &table->kerningPairs[middle];
+        uint32_t pairKey = (pair->first << 8) | pair->second;
+        if (pairKey == key) {
+            return pair->adjustment;
+        } else if (pairKey < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return 0;
+}
+
+// Measures text without calling out to the renderer. The advances are summed into four separate totals so that each
+// addition doesn't have to wait for the one before it to finish.
+Clay_Dimensions Clay__MeasureTextWithGlyphAdvances(Clay_String *text, Clay_TextElementConfig *config, Clay__GlyphAdvanceTableEntry *entry) {
+    Clay_GlyphAdvanceTable *table = entry->table;
+    const uint8_t *chars = (const uint8_t *)text->chars;
+    int32_t length = text->length;
+    float sums[4] = {0};
+    int32_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        sums[0] += table->advances[chars[i]];
+        sums[1] += table->advances[chars[i + 1]];
+        sums[2] += table->advances[chars[i + 2]];
+        sums[3] += table->advances[chars[i + 3]];
+    }
+    for (; i < length; ++i) {
+        sums[0] += table->advances[chars[i]];
+    }
+    float width = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    if (table->kerningPairCount > 0) {
+        for (int32_t j = 0; j < length - 1; ++j) {
+            if (entry->kerningFirstMask[chars[j] >> 5] & (1u << (chars[j] & 31))) {
+                width += Clay__FindKerningAdjustment(table, chars[j], chars[j + 1]);
+            }
+        }
+    }
+    if (length > 1) {
+        width += (float)config->letterSpacing * (float)(length - 1);
+    }
+    return CLAY__INIT(Clay_Dimensions) { width, table->lineHeight };
+}
+
+Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_TextElementConfig *config) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    bool batched = Clay__MeasureTextBatch != CLAY__NULL;
+    #ifndef CLAY_WASM
+    if (!Clay__MeasureText && !batched && context->glyphAdvanceTables.length == 0) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_FUNCTION_NOT_PROVIDED,
+            .errorText = CLAY_STRING("Clay's internal MeasureText function is null. You may have forgotten to call Clay_SetMeasureTextFunction(), or passed a NULL function pointer by mistake."),
+            .userData = context->errorHandler.userData });
+        return NULL;
+    }
+    #endif
+    uint32_t id = Clay__HashTextWithConfig(text, config);
+    uint32_t hashBucket = id % (context->maxMeasureTextCacheWordCount / 32);
+    int32_t elementIndexPrevious = 0;
+    int32_t elementIndex = context->measureTextHashMap.internalArray[hashBucket];
+    while (elementIndex != 0) {
+        Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex);
+        if (hashEntry->id == id) {
+            hashEntry->generation = context->generation;
+            return hashEntry;
+        }
+        // This element hasn't been seen in a few frames, delete the hash map item
+        if (context->generation - hashEntry->generation > 2) {
+            // The measured words are left in place, and reclaimed the next time the words are compacted
+            if (hashEntry->measuredWordsCount > 0) {
+                context->measuredWordOwners.internalArray[hashEntry->measuredWordsStartIndex] = -1;
+                context->measuredWordsEvictedCount += hashEntry->measuredWordsCount;
+            }
+
+            uint32_t nextIndex = hashEntry->nextIndex;
+            Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, elementIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1 });
+            Clay__int32_tArray_Add(&context->measureTextHashMapInternalFreeList, elementIndex);
+            if (elementIndexPrevious == 0) {
+                context->measureTextHashMap.internalArray[hashBucket] = nextIndex;
+            } else {
+                Clay__MeasureTextCacheItem *previousHashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious);
+                previousHashEntry->nextIndex = nextIndex;
+            }
+            elementIndex = nextIndex;
+        } else {
+            elementIndexPrevious = elementIndex;
+            elementIndex = hashEntry->nextIndex;
+        }
+    }
+
+    uint32_t newItemIndex = 0;
+    Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .id = id, .generation = context->generation };
+    Clay__MeasureTextCacheItem *measured = NULL;
+    if (context->measureTextHashMapInternalFreeList.length > 0) {
+        newItemIndex = Clay__int32_tArray_Get(&context->measureTextHashMapInternalFreeList, context->measureTextHashMapInternalFreeList.length - 1);
+        context->measureTextHashMapInternalFreeList.length--;
+        Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, newItemIndex, newCacheItem);
+        measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, newItemIndex);
+    } else {
+        if (context->measureTextHashMapInternal.length == context->measureTextHashMapInternal.capacity - 1) {
+            if (context->booleanWarnings.maxTextMeasureCacheExceeded) {
+                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                        .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+                        .errorText = CLAY_STRING("Clay ran out of capacity while attempting to measure text elements. Try using Clay_SetMaxElementCount() with a higher value."),
+                        .userData = context->errorHandler.userData });
+                context->booleanWarnings.maxTextMeasureCacheExceeded = true;
+            }
+            return &CLAY__MEASURE_TEXT_CACHE_ITEM_DEFAULT;
+        }
+        measured = Clay__MeasureTextCacheItemArray_Add(&context->measureTextHashMapInternal, newCacheItem);
+        newItemIndex = context->measureTextHashMapInternal.length - 1;
+    }
+    if (context->wrappedLinesCacheEntries.internalArray) {
+        context->wrappedLinesCacheEntries.internalArray[newItemIndex] = CLAY__INIT(Clay__WrappedLinesCacheEntry) {0};
+    }
+
+    // Every space and newline can end a word, and newlines are also stored as a word of their own
+    uint32_t maxWordCount = 1;
+    for (uint32_t i = 0; i < text->length; ++i) {
+        maxWordCount += text->chars[i] == '\n' ? 2 : text->chars[i] == ' ' ? 1 : 0;
+    }
+    int32_t wordsStartIndex = Clay__AllocateMeasuredWords(maxWordCount);
+    if (wordsStartIndex == -1) {
+        if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
+                .userData = context->errorHandler.userData });
+            context->booleanWarnings.maxTextMeasureCacheExceeded = true;
+        }
+        return &CLAY__MEASURE_TEXT_CACHE_ITEM_DEFAULT;
+    }
+    measured->measuredWordsStartIndex = wordsStartIndex;
+    Clay__MeasuredWord *words = &context->measuredWords.internalArray[wordsStartIndex];
+
+    uint32_t start = 0;
+    uint32_t end = 0;
+    float measuredWidth = 0;
+    float measuredHeight = 0;
+    // Fonts with a registered advance table are measured immediately, without calling out to the renderer
+    Clay__GlyphAdvanceTableEntry *glyphAdvanceTable = Clay__FindGlyphAdvanceTable(config);
+    if (glyphAdvanceTable) {
+        batched = false;
+    }
+    // When batching, only words that haven't been measured before, in any string, wait for the batch. They are given
+    // zero sized placeholders until then, which the batch adds their measurements to. Until the width of a space has been
+    // measured in this config, every word waits for it.
+    float spaceWidth = 0;
+    bool spaceWidthQueued = false;
+    if (glyphAdvanceTable) {
+        spaceWidth = Clay__MeasureTextWithGlyphAdvances(&CLAY__SPACECHAR, config, glyphAdvanceTable).width;
+    } else if (batched) {
+        Clay__MeasuredWordKey spaceWordKey = Clay__HashWordWithConfig(&CLAY__SPACECHAR, config);
+        Clay_Dimensions *cachedSpaceDimensions = Clay__FindMeasuredWordDimensions(spaceWordKey);
+        if (cachedSpaceDimensions) {
+            spaceWidth = cachedSpaceDimensions->width;
+        } else {
+            Clay__QueueMeasureText(CLAY__SPACECHAR, config, CLAY__INIT(Clay__MeasureTextBatchTarget) { .cacheItemIndex = (int32_t)newItemIndex, .measuredWordIndex = -1, .isSpaceWidth = true, .wordKey = spaceWordKey });
+            spaceWidthQueued = true;
+        }
+    } else {
+        spaceWidth = Clay__MeasureWordCached(&CLAY__SPACECHAR, config).width;
+    }
+    while (end < text->length) {
+        char current = text->chars[end];
+        if (current == ' ' || current == '\n') {
+            uint32_t length = end - start;
             Clay_String word = { .length = length, .chars = &text->chars[start] };
-            Clay_Dimensions dimensions = Clay__MeasureText(&word, config);
+            Clay__MeasuredWordKey wordKey = batched ? Clay__HashWordWithConfig(&word, config) : CLAY__INIT(Clay__MeasuredWordKey) {0};
+            Clay_Dimensions *cachedDimensions = batched ? Clay__FindMeasuredWordDimensions(wordKey) : CLAY__NULL;
+            bool queued = batched && (!cachedDimensions || spaceWidthQueued);
+            Clay_Dimensions dimensions = glyphAdvanceTable ? Clay__MeasureTextWithGlyphAdvances(&word, config, glyphAdvanceTable) : !batched ? Clay__MeasureWordCached(&word, config) : queued ? CLAY__INIT(Clay_Dimensions) {0} : *cachedDimensions;
+            int32_t measuredWordIndex = -1;
             if (current == ' ') {
                 dimensions.width += spaceWidth;
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = dimensions.width, .next = -1 }, previousWord);
+                measuredWordIndex = wordsStartIndex + (int32_t)measured->measuredWordsCount;
+                words[measured->measuredWordsCount++] = CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = dimensions.width };
             }
             if (current == '\n') {
                 if (length > 1) {
-                    previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = dimensions.width, .next = -1 }, previousWord);
+                    measuredWordIndex = wordsStartIndex + (int32_t)measured->measuredWordsCount;
+                    words[measured->measuredWordsCount++] = CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = dimensions.width };
                 }
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0, .next = -1 }, previousWord);
+                words[measured->measuredWordsCount++] = CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0 };
+            }
+            if (queued) {
+                Clay__QueueMeasureText(word, config, CLAY__INIT(Clay__MeasureTextBatchTarget) { .cacheItemIndex = (int32_t)newItemIndex, .measuredWordIndex = measuredWordIndex, .followedBySpace = current == ' ' && spaceWidthQueued, .wordKey = wordKey });
+            } else {
+                measuredHeight = dimensions.height;
             }
             measuredWidth += dimensions.width;
-            measuredHeight = dimensions.height;
             start = end + 1;
         }
         end++;
     }
     if (end - start > 0) {
         Clay_String lastWord = { .length = end - start, .chars = &text->chars[start] };
-        Clay_Dimensions dimensions = Clay__MeasureText(&lastWord, config);
-        Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start, .width = dimensions.width, .next = -1 }, previousWord);
+        Clay__MeasuredWordKey wordKey = batched ? Clay__HashWordWithConfig(&lastWord, config) : CLAY__INIT(Clay__MeasuredWordKey) {0};
+        Clay_Dimensions *cachedDimensions = batched ? Clay__FindMeasuredWordDimensions(wordKey) : CLAY__NULL;
+        bool queued = batched && (!cachedDimensions || spaceWidthQueued);
+        Clay_Dimensions dimensions = glyphAdvanceTable ? Clay__MeasureTextWithGlyphAdvances(&lastWord, config, glyphAdvanceTable) : !batched ? Clay__MeasureWordCached(&lastWord, config) : queued ? CLAY__INIT(Clay_Dimensions) {0} : *cachedDimensions;
+        int32_t measuredWordIndex = wordsStartIndex + (int32_t)measured->measuredWordsCount;
+        words[measured->measuredWordsCount++] = CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start, .width = dimensions.width };
+        if (queued) {
+            Clay__QueueMeasureText(lastWord, config, CLAY__INIT(Clay__MeasureTextBatchTarget) { .cacheItemIndex = (int32_t)newItemIndex, .measuredWordIndex = measuredWordIndex, .wordKey = wordKey });
+        } else {
+            measuredHeight = dimensions.height;
+        }
         measuredWidth += dimensions.width;
-        measuredHeight = dimensions.height;
     }
-    measured->measuredWordsStartIndex = tempWord.next;
-    measured->unwrappedDimensions.width = measuredWidth;
-    measured->unwrappedDimensions.height = measuredHeight;
+    // Only as many words as were found are kept, the rest of the space goes back to the end of the array
+    context->measuredWords.length = (uint32_t)wordsStartIndex + measured->measuredWordsCount;
+    if (measured->measuredWordsCount > 0) {
+        context->measuredWordOwners.internalArray[wordsStartIndex] = (int32_t)newItemIndex;
+    }
+    Clay__UpdateMeasuredWordsWidthBefore(measured);
+    // Queued words are added to the cache item as the batch resolves them, which can already have happened if it filled up
+    measured->unwrappedDimensions.width += measuredWidth;
+    measured->unwrappedDimensions.height = CLAY__MAX(measured->unwrappedDimensions.height, measuredHeight);
 
     if (elementIndexPrevious != 0) {
-        Clay__MeasureTextCacheItemArray_Get(&Clay__measureTextHashMapInternal, elementIndexPrevious)->nextIndex = newItemIndex;
+        Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious)->nextIndex = newItemIndex;
     } else {
-        Clay__measureTextHashMap.internalArray[hashBucket] = newItemIndex;
+        context->measureTextHashMap.internalArray[hashBucket] = newItemIndex;
     }
     return measured;
 }
@@ -1730,69 +2900,152 @@ bool Clay__PointIsInsideRect(Clay_Vector2 point, Clay_BoundingBox rect) {
     return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
 }
 
+// Returns the slot holding the id, or the empty slot where it would be inserted. The table capacity is a power of two at
+// least twice the element limit, so probing always terminates at an empty slot.
+Clay__LayoutElementHashMapSlot *Clay__FindHashMapSlot(uint32_t id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementHashMapSlotArray *hashMap = &context->layoutElementsHashMap;
+    uint32_t slotIndex = id & (hashMap->capacity - 1);
+    while (hashMap->internalArray[slotIndex].itemIndex != -1 && hashMap->internalArray[slotIndex].id != id) {
+        slotIndex = (slotIndex + 1) & (hashMap->capacity - 1);
+    }
+    return &hashMap->internalArray[slotIndex];
+}
+
+Clay_LayoutElementHashMapItem *Clay__GetHashMapSlotItem(Clay__LayoutElementHashMapSlot *slot) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (slot->itemIndex == -1) {
+        return &CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT;
+    }
+    return &context->layoutElementsHashMapInternal.internalArray[slot->itemIndex];
+}
+
+// Returns NULL until incremental layout has been enabled for the first time
+Clay__LayoutCacheData *Clay__GetLayoutCache(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->layoutCaches.internalArray ? &context->layoutCaches.internalArray[itemIndex] : CLAY__NULL;
+}
+
 Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Clay_LayoutElement* layoutElement) {
-    if (Clay__layoutElementsHashMapInternal.length == Clay__layoutElementsHashMapInternal.capacity - 1) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->layoutElementsHashMapInternal.length == context->layoutElementsHashMapInternal.capacity - 1) {
         return NULL;
     }
-    Clay_LayoutElementHashMapItem item = { .elementId = elementId, .layoutElement = layoutElement, .nextIndex = -1, .generation = Clay__generation + 1 };
-    uint32_t hashBucket = elementId.id % Clay__layoutElementsHashMap.capacity;
-    int32_t hashItemPrevious = -1;
-    int32_t hashItemIndex = Clay__layoutElementsHashMap.internalArray[hashBucket];
-    while (hashItemIndex != -1) { // Just replace collision, not a big deal - leave it up to the end user
-        Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&Clay__layoutElementsHashMapInternal, hashItemIndex);
-        if (hashItem->elementId.id == elementId.id) { // Collision - resolve based on generation
-            item.nextIndex = hashItem->nextIndex;
-            if (hashItem->generation <= Clay__generation) { // First collision - assume this is the "same" element
-                hashItem->generation = Clay__generation + 1;
-                hashItem->layoutElement = layoutElement;
-                hashItem->debugData->collision = false;
-            } else { // Multiple collisions this frame - two elements have the same ID
-                Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_DUPLICATE_ID,
-                    .errorText = CLAY_STRING("An element with this ID was already previously declared during this layout."),
-                    .userData = Clay__errorHandler.userData });
-                if (Clay__debugModeEnabled) {
-                    hashItem->debugData->collision = true;
-                }
+    Clay__LayoutElementHashMapSlot *slot = Clay__FindHashMapSlot(elementId.id);
+    if (slot->itemIndex != -1) { // Collision - resolve based on generation
+        Clay_LayoutElementHashMapItem *hashItem = &context->layoutElementsHashMapInternal.internalArray[slot->itemIndex];
+        if (hashItem->generation <= context->generation) { // First collision - assume this is the "same" element
+            hashItem->generation = context->generation + 1;
+            slot->layoutElement = layoutElement;
+            hashItem->debugData->collision = false;
+            layoutElement->layoutCache = Clay__GetLayoutCache(slot->itemIndex);
+        } else { // Multiple collisions this frame - two elements have the same ID
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_DUPLICATE_ID,
+                .errorText = CLAY_STRING("An element with this ID was already previously declared during this layout."),
+                .userData = context->errorHandler.userData });
+            if (context->debugModeEnabled) {
+                hashItem->debugData->collision = true;
             }
-            return hashItem;
         }
-        hashItemPrevious = hashItemIndex;
-        hashItemIndex = hashItem->nextIndex;
-    }
-    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Add(&Clay__layoutElementsHashMapInternal, item);
-    hashItem->debugData = Clay__DebugElementDataArray_Add(&Clay__debugElementData, CLAY__INIT(Clay__DebugElementData) {0});
-    if (hashItemPrevious != -1) {
-        Clay__LayoutElementHashMapItemArray_Get(&Clay__layoutElementsHashMapInternal, hashItemPrevious)->nextIndex = (int32_t)Clay__layoutElementsHashMapInternal.length - 1;
-    } else {
-        Clay__layoutElementsHashMap.internalArray[hashBucket] = (int32_t)Clay__layoutElementsHashMapInternal.length - 1;
+        return hashItem;
     }
+    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Add(&context->layoutElementsHashMapInternal, CLAY__INIT(Clay_LayoutElementHashMapItem) { .elementId = elementId, .generation = context->generation + 1 });
+    hashItem->debugData = Clay__DebugElementDataArray_Add(&context->debugElementData, CLAY__INIT(Clay__DebugElementData) {0});
+    *slot = CLAY__INIT(Clay__LayoutElementHashMapSlot) { .id = elementId.id, .itemIndex = (int32_t)context->layoutElementsHashMapInternal.length - 1, .layoutElement = layoutElement };
+    layoutElement->layoutCache = Clay__GetLayoutCache(slot->itemIndex);
     return hashItem;
 }
 
 Clay_LayoutElementHashMapItem *Clay__GetHashMapItem(uint32_t id) {
-    uint32_t hashBucket = id % Clay__layoutElementsHashMap.capacity;
-    int32_t elementIndex = Clay__layoutElementsHashMap.internalArray[hashBucket];
-    while (elementIndex != -1) {
-        Clay_LayoutElementHashMapItem *hashEntry = Clay__LayoutElementHashMapItemArray_Get(&Clay__layoutElementsHashMapInternal, elementIndex);
-        if (hashEntry->elementId.id == id) {
-            return hashEntry;
-        }
-        elementIndex = hashEntry->nextIndex;
+    return Clay__GetHashMapSlotItem(Clay__FindHashMapSlot(id));
+}
+
+// Hot lookup for the layout element and bounding box of an id, which doesn't touch the cold item array
+Clay__LayoutElementHashMapSlot *Clay__GetHashMapSlot(uint32_t id) {
+    Clay__LayoutElementHashMapSlot *slot = Clay__FindHashMapSlot(id);
+    return slot->itemIndex == -1 ? &CLAY__LAYOUT_ELEMENT_HASH_MAP_SLOT_DEFAULT : slot;
+}
+
+// Returns the index slot holding the element id's scroll container, or the empty slot where it would be inserted
+int32_t *Clay__FindScrollContainerDataIndex(uint32_t elementId) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__int32_tArray *indices = &context->scrollContainerDataIndices;
+    uint32_t slotIndex = elementId & (indices->capacity - 1);
+    while (indices->internalArray[slotIndex] != -1 && context->scrollContainerDatas.internalArray[indices->internalArray[slotIndex]].elementId != elementId) {
+        slotIndex = (slotIndex + 1) & (indices->capacity - 1);
+    }
+    return &indices->internalArray[slotIndex];
+}
+
+Clay__ScrollContainerDataInternal *Clay__GetScrollContainerData(uint32_t elementId) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t index = *Clay__FindScrollContainerDataIndex(elementId);
+    return index == -1 ? CLAY__NULL : &context->scrollContainerDatas.internalArray[index];
+}
+
+// Scroll containers are only removed once per frame, so the index is rebuilt afterwards rather than supporting deletion
+void Clay__RebuildScrollContainerDataIndices(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (uint32_t i = 0; i < context->scrollContainerDataIndices.capacity; ++i) {
+        context->scrollContainerDataIndices.internalArray[i] = -1;
+    }
+    for (uint32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
+        *Clay__FindScrollContainerDataIndex(context->scrollContainerDatas.internalArray[i].elementId) = (int32_t)i;
     }
-    return &CLAY__LAYOUT_ELEMENT_HASH_MAP_ITEM_DEFAULT;
 }
 
 void Clay__GenerateIdForAnonymousElement(Clay_LayoutElement *openLayoutElement) {
-    Clay_LayoutElement *parentElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&Clay__openLayoutElementStack, Clay__openLayoutElementStack.length - 2));
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElement *parentElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_Get(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2));
     Clay_ElementId elementId = Clay__HashNumber(parentElement->childrenOrTextContent.children.length, parentElement->id);
     openLayoutElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, openLayoutElement);
-    Clay__StringArray_Add(&Clay__layoutElementIdStrings, elementId.stringId);
+    Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
+}
+
+// Works out which items of a virtual list are visible, from the scroll position and size of the container last frame
+void Clay__UpdateVirtualItemsRange(Clay__ScrollContainerDataInternal *scrollContainerData, Clay_LayoutElement *layoutElement, Clay_ScrollElementConfig *scrollConfig) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig ? layoutElement->layoutConfig : &CLAY_LAYOUT_DEFAULT;
+    bool vertical = layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM;
+    float itemPitch = scrollConfig->virtualItemSize + (float)layoutConfig->childGap;
+    float visibleStart = -(vertical ? scrollContainerData->scrollPosition.y : scrollContainerData->scrollPosition.x) - (float)(vertical ? layoutConfig->padding.y : layoutConfig->padding.x);
+    float visibleSize = vertical ? scrollContainerData->boundingBox.height : scrollContainerData->boundingBox.width;
+    // Before the container has been laid out for the first time, assume that it could fill the whole layout
+    if (visibleSize <= 0) {
+        visibleSize = vertical ? context->layoutDimensions.height : context->layoutDimensions.width;
+    }
+    if (itemPitch <= 0) {
+        scrollContainerData->virtualItemsStartIndex = 0;
+        scrollContainerData->virtualItemsEndIndex = scrollConfig->virtualItemCount;
+        return;
+    }
+    float startIndex = CLAY__MAX(visibleStart / itemPitch, 0);
+    float endIndex = CLAY__MAX((visibleStart + visibleSize) / itemPitch + 1, 0);
+    scrollContainerData->virtualItemsStartIndex = (uint32_t)CLAY__MIN(startIndex, (float)scrollConfig->virtualItemCount);
+    scrollContainerData->virtualItemsEndIndex = (uint32_t)CLAY__MIN(endIndex, (float)scrollConfig->virtualItemCount);
+}
+
+// Adds an empty child taking up the space of a number of virtual list items, less the child gap either side of it
+void Clay__AddVirtualItemsSpacer(Clay_LayoutElement *listElement, Clay_ScrollElementConfig *scrollConfig, uint32_t itemCount) {
+    Clay_LayoutConfig *listLayoutConfig = listElement->layoutConfig;
+    float size = CLAY__MAX((float)itemCount * (scrollConfig->virtualItemSize + (float)listLayoutConfig->childGap) - (float)listLayoutConfig->childGap, 0);
+    Clay_LayoutConfig spacerLayoutConfig = CLAY_LAYOUT_DEFAULT;
+    if (listLayoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM) {
+        spacerLayoutConfig.sizing.height = CLAY_SIZING_FIXED(size);
+    } else {
+        spacerLayoutConfig.sizing.width = CLAY_SIZING_FIXED(size);
+    }
+    Clay__OpenElement();
+    Clay__AttachLayoutConfig(Clay__StoreLayoutConfig(spacerLayoutConfig));
+    Clay__ElementPostConfiguration();
+    Clay__CloseElement();
 }
 
 void Clay__ElementPostConfiguration(void) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
@@ -1806,9 +3059,9 @@ void Clay__ElementPostConfiguration(void) {
     }
 
     // Loop through element configs and handle special cases
-    openLayoutElement->elementConfigs.internalArray = &Clay__elementConfigs.internalArray[Clay__elementConfigs.length];
+    openLayoutElement->elementConfigs.internalArray = &context->elementConfigs.internalArray[context->elementConfigs.length];
     for (uint32_t elementConfigIndex = 0; elementConfigIndex < openLayoutElement->elementConfigs.length; elementConfigIndex++) {
-        Clay_ElementConfig *config = Clay__ElementConfigArray_Add(&Clay__elementConfigs, *Clay__ElementConfigArray_Get(&Clay__elementConfigBuffer, Clay__elementConfigBuffer.length - openLayoutElement->elementConfigs.length + elementConfigIndex));
+        Clay_ElementConfig *config = Clay__ElementConfigArray_Add(&context->elementConfigs, *Clay__ElementConfigArray_Get(&context->elementConfigBuffer, context->elementConfigBuffer.length - openLayoutElement->elementConfigs.length + elementConfigIndex));
         openLayoutElement->configsEnabled |= config->type;
         switch (config->type) {
             case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE:
@@ -1816,32 +3069,36 @@ void Clay__ElementPostConfiguration(void) {
             case CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER: {
                 Clay_FloatingElementConfig *floatingConfig = config->config.floatingElementConfig;
                 // This looks dodgy but because of the auto generated root element the depth of the tree will always be at least 2 here
-                Clay_LayoutElement *hierarchicalParent = Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&Clay__openLayoutElementStack, Clay__openLayoutElementStack.length - 2));
+                Clay_LayoutElement *hierarchicalParent = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_Get(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2));
                 if (!hierarchicalParent) {
                     break;
                 }
+                if (!Clay__ElementCategoryCapacityCheck(context->layoutElementTreeRoots.length, context->layoutElementTreeRoots.capacity, CLAY_STRING("Clay ran out of capacity while attempting to create a floating element. Try using Clay_SetMaxFloatingElementCount() with a higher value."))) {
+                    context->booleanWarnings.maxElementsExceeded = true;
+                    break;
+                }
                 int clipElementId = 0;
                 if (floatingConfig->parentId == 0) {
                     // If no parent id was specified, attach to the elements direct hierarchical parent
                     Clay_FloatingElementConfig newConfig = *floatingConfig;
                     newConfig.parentId = hierarchicalParent->id;
-                    floatingConfig = Clay__FloatingElementConfigArray_Add(&Clay__floatingElementConfigs, newConfig);
+                    floatingConfig = Clay__StoreFloatingElementConfig(newConfig);
                     config->config.floatingElementConfig = floatingConfig;
-                    if (Clay__openClipElementStack.length > 0) {
-                        clipElementId = Clay__int32_tArray_Get(&Clay__openClipElementStack, (int)Clay__openClipElementStack.length - 1);
+                    if (context->openClipElementStack.length > 0) {
+                        clipElementId = Clay__int32_tArray_Get(&context->openClipElementStack, (int)context->openClipElementStack.length - 1);
                     }
                 } else {
-                    Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingConfig->parentId);
-                    clipElementId = Clay__int32_tArray_Get(&Clay__layoutElementClipElementIds, parentItem->layoutElement - Clay__layoutElements.internalArray);
-                    if (!parentItem) {
-                        Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                    Clay__LayoutElementHashMapSlot *parentSlot = Clay__GetHashMapSlot(floatingConfig->parentId);
+                    clipElementId = Clay__int32_tArray_Get(&context->layoutElementClipElementIds, parentSlot->layoutElement - context->layoutElements.internalArray);
+                    if (!parentSlot) {
+                        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                             .errorType = CLAY_ERROR_TYPE_FLOATING_CONTAINER_PARENT_NOT_FOUND,
                             .errorText = CLAY_STRING("A floating element was declared with a parentId, but no element with that ID was found."),
-                            .userData = Clay__errorHandler.userData });
+                            .userData = context->errorHandler.userData });
                     }
                 }
-                Clay__LayoutElementTreeRootArray_Add(&Clay__layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) {
-                    .layoutElementIndex = (uint32_t)Clay__int32_tArray_Get(&Clay__openLayoutElementStack, Clay__openLayoutElementStack.length - 1),
+                Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) {
+                    .layoutElementIndex = (uint32_t)Clay__int32_tArray_Get(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1),
                     .parentId = floatingConfig->parentId,
                     .clipElementId = (uint32_t)clipElementId,
                     .zIndex = floatingConfig->zIndex,
@@ -1849,106 +3106,177 @@ void Clay__ElementPostConfiguration(void) {
                 break;
             }
             case CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER: {
-                Clay__int32_tArray_Add(&Clay__openClipElementStack, (int)openLayoutElement->id);
+                Clay__int32_tArray_Add(&context->openClipElementStack, (int)openLayoutElement->id);
                 // Retrieve or create cached data to track scroll position across frames
+                int32_t *scrollIndex = Clay__FindScrollContainerDataIndex(openLayoutElement->id);
                 Clay__ScrollContainerDataInternal *scrollOffset = CLAY__NULL;
-                for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; i++) {
-                    Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
-                    if (openLayoutElement->id == mapping->elementId) {
-                        scrollOffset = mapping;
-                        scrollOffset->layoutElement = openLayoutElement;
-                        scrollOffset->openThisFrame = true;
-                    }
-                }
-                if (!scrollOffset) {
-                    scrollOffset = Clay__ScrollContainerDataInternalArray_Add(&Clay__scrollContainerDatas, CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = openLayoutElement, .scrollOrigin = {-1,-1}, .elementId = openLayoutElement->id, .openThisFrame = true});
+                if (*scrollIndex != -1) {
+                    scrollOffset = &context->scrollContainerDatas.internalArray[*scrollIndex];
+                    scrollOffset->layoutElement = openLayoutElement;
+                    scrollOffset->openThisFrame = true;
+                } else if (context->scrollContainerDatas.length == context->scrollContainerDatas.capacity) {
+                    context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                        .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+                        .errorText = CLAY_STRING("Clay ran out of capacity while attempting to create a scroll container. Try using Clay_SetMaxScrollContainerCount() with a higher value."),
+                        .userData = context->errorHandler.userData });
+                    scrollOffset = &CLAY__SCROLL_CONTAINER_DEFAULT;
+                } else {
+                    *scrollIndex = (int32_t)context->scrollContainerDatas.length;
+                    scrollOffset = Clay__ScrollContainerDataInternalArray_Add(&context->scrollContainerDatas, CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = openLayoutElement, .scrollOrigin = {-1,-1}, .elementId = openLayoutElement->id, .openThisFrame = true});
                 }
-                if (Clay__externalScrollHandlingEnabled) {
+                if (context->externalScrollHandlingEnabled) {
                     scrollOffset->scrollPosition = Clay__QueryScrollOffset(scrollOffset->elementId);
                 }
+                if (config->config.scrollElementConfig->virtualItemCount > 0) {
+                    Clay__UpdateVirtualItemsRange(scrollOffset, openLayoutElement, config->config.scrollElementConfig);
+                }
                 break;
             }
             case CLAY__ELEMENT_CONFIG_TYPE_CUSTOM: break;
             case CLAY__ELEMENT_CONFIG_TYPE_IMAGE: {
-                Clay__LayoutElementPointerArray_Add(&Clay__imageElementPointers, openLayoutElement);
+                if (!Clay__ElementCategoryCapacityCheck(context->imageElementPointers.length, context->imageElementPointers.capacity, CLAY_STRING("Clay ran out of capacity while attempting to create an image element. Try using Clay_SetMaxImageElementCount() with a higher value."))) {
+                    context->booleanWarnings.maxElementsExceeded = true;
+                    break;
+                }
+                Clay__LayoutElementPointerArray_Add(&context->imageElementPointers, openLayoutElement);
                 break;
             }
             case CLAY__ELEMENT_CONFIG_TYPE_TEXT:
             default: break;
         }
     }
-    Clay__elementConfigBuffer.length -= openLayoutElement->elementConfigs.length;
+    context->elementConfigBuffer.length -= openLayoutElement->elementConfigs.length;
+    // Reserve the space of the virtual list items before the visible ones
+    if (Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__GetScrollContainerData(openLayoutElement->id);
+        if (scrollConfig->virtualItemCount > 0 && scrollContainerData && scrollContainerData->virtualItemsStartIndex > 0) {
+            Clay__AddVirtualItemsSpacer(openLayoutElement, scrollConfig, scrollContainerData->virtualItemsStartIndex);
+        }
+    }
 }
 
-void Clay__CloseElement(void) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
-        return;
+uint32_t Clay__HashLayoutFloat(uint32_t hash, float value) {
+    union { float floatValue; uint32_t intValue; } bits = { .floatValue = value };
+    return Clay__HashLayoutValue(hash, bits.intValue);
+}
+
+// Hashes everything that can affect the size of an element and its descendants, and marks the element's subtree as unchanged
+// if the hash matches the one stored by the previous frame.
+void Clay__UpdateLayoutCacheHash(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t hash = Clay__HashLayoutValue(layoutElement->id, layoutElement->configsEnabled);
+    bool childrenUnchanged = true;
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+        Clay_TextElementConfig *textConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig;
+        Clay_String text = layoutElement->childrenOrTextContent.textElementData->text;
+        for (size_t i = 0; i < text.length; i++) {
+            hash = Clay__HashLayoutValue(hash, (uint8_t)text.chars[i]);
+        }
+        hash = Clay__HashLayoutValue(hash, text.length);
+        hash = Clay__HashLayoutValue(hash, textConfig->fontId);
+        hash = Clay__HashLayoutValue(hash, textConfig->fontSize);
+        hash = Clay__HashLayoutValue(hash, textConfig->letterSpacing);
+        hash = Clay__HashLayoutValue(hash, textConfig->lineHeight);
+        hash = Clay__HashLayoutValue(hash, textConfig->wrapMode);
+    } else {
+        Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+        hash = Clay__HashLayoutValue(hash, layoutConfig->sizing.width.type);
+        hash = Clay__HashLayoutFloat(hash, layoutConfig->sizing.width.size.minMax.min);
+        hash = Clay__HashLayoutFloat(hash, layoutConfig->sizing.width.size.minMax.max);
+        hash = Clay__HashLayoutValue(hash, layoutConfig->sizing.height.type);
+        hash = Clay__HashLayoutFloat(hash, layoutConfig->sizing.height.size.minMax.min);
+        hash = Clay__HashLayoutFloat(hash, layoutConfig->sizing.height.size.minMax.max);
+        hash = Clay__HashLayoutValue(hash, layoutConfig->padding.x);
+        hash = Clay__HashLayoutValue(hash, layoutConfig->padding.y);
+        hash = Clay__HashLayoutValue(hash, layoutConfig->childGap);
+        hash = Clay__HashLayoutValue(hash, layoutConfig->layoutDirection);
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+            Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+            hash = Clay__HashLayoutValue(hash, scrollConfig->horizontal | (scrollConfig->vertical << 1));
+        }
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
+            Clay_ImageElementConfig *imageConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE).imageElementConfig;
+            hash = Clay__HashLayoutFloat(hash, imageConfig->sourceDimensions.width);
+            hash = Clay__HashLayoutFloat(hash, imageConfig->sourceDimensions.height);
+        }
+        for (int i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            hash = Clay__HashLayoutValue(hash, childElement->layoutHash);
+            childrenUnchanged = childrenUnchanged && childElement->layoutCache && childElement->layoutCache->subtreeUnchanged;
+        }
     }
-    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    Clay_LayoutConfig *layoutConfig = openLayoutElement->layoutConfig;
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    layoutElement->layoutHash = hash;
+    Clay__LayoutCacheData *layoutCache = layoutElement->layoutCache;
+    if (layoutCache) {
+        layoutCache->subtreeUnchanged = childrenUnchanged && layoutCache->validGeneration == context->generation && layoutCache->layoutHash == hash;
+        layoutCache->restored = false;
+    }
+}
+
+// Sizes an element to fit its children, then clamps the result to the min and max sizes configured in its layout
+void Clay__CalculateFitDimensions(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
     bool elementHasScrollHorizontal = false;
     bool elementHasScrollVertical = false;
-    if (Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+    if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
         elementHasScrollHorizontal = scrollConfig->horizontal;
         elementHasScrollVertical = scrollConfig->vertical;
-        Clay__openClipElementStack.length--;
     }
+    layoutElement->dimensions = CLAY__INIT(Clay_Dimensions) {0};
+    layoutElement->minDimensions = CLAY__INIT(Clay_Dimensions) {0};
 
-    // Attach children to the current open element
-    openLayoutElement->childrenOrTextContent.children.elements = &Clay__layoutElementChildren.internalArray[Clay__layoutElementChildren.length];
     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-        openLayoutElement->dimensions.width = layoutConfig->padding.x * 2;
-        for (int i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_Get(&Clay__layoutElementChildrenBuffer, (int)Clay__layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&Clay__layoutElements, childIndex);
-            openLayoutElement->dimensions.width += child->dimensions.width;
-            openLayoutElement->dimensions.height = CLAY__MAX(openLayoutElement->dimensions.height, child->dimensions.height + layoutConfig->padding.y * 2);
+        layoutElement->dimensions.width = layoutConfig->padding.x * 2;
+        for (int i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            layoutElement->dimensions.width += child->dimensions.width;
+            layoutElement->dimensions.height = CLAY__MAX(layoutElement->dimensions.height, child->dimensions.height + layoutConfig->padding.y * 2);
             // Minimum size of child elements doesn't matter to scroll containers as they can shrink and hide their contents
             if (!elementHasScrollHorizontal) {
-                openLayoutElement->minDimensions.width += child->minDimensions.width;
+                layoutElement->minDimensions.width += child->minDimensions.width;
             }
             if (!elementHasScrollVertical) {
-                openLayoutElement->minDimensions.height = CLAY__MAX(openLayoutElement->minDimensions.height, child->minDimensions.height + layoutConfig->padding.y * 2);
+                layoutElement->minDimensions.height = CLAY__MAX(layoutElement->minDimensions.height, child->minDimensions.height + layoutConfig->padding.y * 2);
             }
-            Clay__int32_tArray_Add(&Clay__layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.width += childGap; // TODO this is technically a bug with childgap and scroll containers
-        openLayoutElement->minDimensions.width += childGap;
+        float childGap = (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.width += childGap; // TODO this is technically a bug with childgap and scroll containers
+        layoutElement->minDimensions.width += childGap;
     }
     else if (layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM) {
-        openLayoutElement->dimensions.height = layoutConfig->padding.y * 2;
-        for (int i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_Get(&Clay__layoutElementChildrenBuffer, (int)Clay__layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&Clay__layoutElements, childIndex);
-            openLayoutElement->dimensions.height += child->dimensions.height;
-            openLayoutElement->dimensions.width = CLAY__MAX(openLayoutElement->dimensions.width, child->dimensions.width + layoutConfig->padding.x * 2);
+        layoutElement->dimensions.height = layoutConfig->padding.y * 2;
+        for (int i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            layoutElement->dimensions.height += child->dimensions.height;
+            layoutElement->dimensions.width = CLAY__MAX(layoutElement->dimensions.width, child->dimensions.width + layoutConfig->padding.x * 2);
             // Minimum size of child elements doesn't matter to scroll containers as they can shrink and hide their contents
             if (!elementHasScrollVertical) {
-                openLayoutElement->minDimensions.height += child->minDimensions.height;
+                layoutElement->minDimensions.height += child->minDimensions.height;
             }
             if (!elementHasScrollHorizontal) {
-                openLayoutElement->minDimensions.width = CLAY__MAX(openLayoutElement->minDimensions.width, child->minDimensions.width + layoutConfig->padding.x * 2);
+                layoutElement->minDimensions.width = CLAY__MAX(layoutElement->minDimensions.width, child->minDimensions.width + layoutConfig->padding.x * 2);
             }
-            Clay__int32_tArray_Add(&Clay__layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.height += childGap; // TODO this is technically a bug with childgap and scroll containers
-        openLayoutElement->minDimensions.height += childGap;
+        float childGap = (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.height += childGap; // TODO this is technically a bug with childgap and scroll containers
+        layoutElement->minDimensions.height += childGap;
     }
 
-    Clay__layoutElementChildrenBuffer.length -= openLayoutElement->childrenOrTextContent.children.length;
-
     // Clamp element min and max width to the values configured in the layout
     if (layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
         if (layoutConfig->sizing.width.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.width.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
-        openLayoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.width = 0;
+        layoutElement->dimensions.width = 0;
     }
 
     // Clamp element min and max height to the values configured in the layout
@@ -1956,42 +3284,79 @@ void Clay__CloseElement(void) {
         if (layoutConfig->sizing.height.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.height.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
-        openLayoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.height = 0;
+        layoutElement->dimensions.height = 0;
+    }
+}
+
+void Clay__CloseElement(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    if (Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+        // Reserve the space of the virtual list items after the visible ones
+        Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__GetScrollContainerData(openLayoutElement->id);
+        if (scrollConfig->virtualItemCount > 0 && scrollContainerData && scrollContainerData->virtualItemsEndIndex < scrollConfig->virtualItemCount) {
+            Clay__AddVirtualItemsSpacer(openLayoutElement, scrollConfig, scrollConfig->virtualItemCount - scrollContainerData->virtualItemsEndIndex);
+        }
+        context->openClipElementStack.length--;
+    }
+
+    // Attach children to the current open element
+    openLayoutElement->childrenOrTextContent.children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
+    for (int i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
+        int32_t childIndex = Clay__int32_tArray_Get(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
+        Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
+    }
+    context->layoutElementChildrenBuffer.length -= openLayoutElement->childrenOrTextContent.children.length;
+
+    Clay__CalculateFitDimensions(openLayoutElement);
+
+    if (context->incrementalLayoutEnabled) {
+        Clay__UpdateLayoutCacheHash(openLayoutElement);
     }
 
     bool elementIsFloating = Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER);
 
     // Close the currently open element
-    int32_t closingElementIndex = Clay__int32_tArray_RemoveSwapback(&Clay__openLayoutElementStack, (int)Clay__openLayoutElementStack.length - 1);
+    int32_t closingElementIndex = Clay__int32_tArray_RemoveSwapback(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1);
     openLayoutElement = Clay__GetOpenLayoutElement();
 
-    if (!elementIsFloating && Clay__openLayoutElementStack.length > 1) {
+    if (!elementIsFloating && context->openLayoutElementStack.length > 1) {
         openLayoutElement->childrenOrTextContent.children.length++;
-        Clay__int32_tArray_Add(&Clay__layoutElementChildrenBuffer, closingElementIndex);
+        Clay__int32_tArray_Add(&context->layoutElementChildrenBuffer, closingElementIndex);
     }
 }
 
 void Clay__OpenElement(void) {
-    if (Clay__layoutElements.length == Clay__layoutElements.capacity - 1 || Clay__booleanWarnings.maxElementsExceeded) {
-        Clay__booleanWarnings.maxElementsExceeded = true;
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
+        context->booleanWarnings.maxElementsExceeded = true;
         return;
     }
     Clay_LayoutElement layoutElement = {0};
-    Clay_LayoutElementArray_Add(&Clay__layoutElements, layoutElement);
-    Clay__int32_tArray_Add(&Clay__openLayoutElementStack, Clay__layoutElements.length - 1);
-    if (Clay__openClipElementStack.length > 0) {
-        Clay__int32_tArray_Set(&Clay__layoutElementClipElementIds, Clay__layoutElements.length - 1, Clay__int32_tArray_Get(&Clay__openClipElementStack, (int)Clay__openClipElementStack.length - 1));
+    Clay_LayoutElementArray_Add(&context->layoutElements, layoutElement);
+    Clay__int32_tArray_Add(&context->openLayoutElementStack, context->layoutElements.length - 1);
+    if (context->openClipElementStack.length > 0) {
+        Clay__int32_tArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, Clay__int32_tArray_Get(&context->openClipElementStack, (int)context->openClipElementStack.length - 1));
     } else {
-        Clay__int32_tArray_Set(&Clay__layoutElementClipElementIds, Clay__layoutElements.length - 1, 0);
+        Clay__int32_tArray_Set(&context->layoutElementClipElementIds, context->layoutElements.length - 1, 0);
     }
 }
 
 void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig) {
-    if (Clay__layoutElements.length == Clay__layoutElements.capacity - 1 || Clay__booleanWarnings.maxElementsExceeded) {
-        Clay__booleanWarnings.maxElementsExceeded = true;
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
+        context->booleanWarnings.maxElementsExceeded = true;
+        return;
+    }
+    if (!Clay__ElementCategoryCapacityCheck(context->textElementData.length, context->textElementData.capacity, CLAY_STRING("Clay ran out of capacity while attempting to create a text element. Try using Clay_SetMaxTextElementCount() with a higher value."))) {
+        context->booleanWarnings.maxElementsExceeded = true;
         return;
     }
     Clay_LayoutElement *parentElement = Clay__GetOpenLayoutElement();
@@ -1999,307 +3364,763 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig)
 
     Clay__OpenElement();
     Clay_LayoutElement * openLayoutElement = Clay__GetOpenLayoutElement();
-    Clay__int32_tArray_Add(&Clay__layoutElementChildrenBuffer, Clay__layoutElements.length - 1);
+    Clay__int32_tArray_Add(&context->layoutElementChildrenBuffer, context->layoutElements.length - 1);
     Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&text, textConfig);
     Clay_ElementId elementId = Clay__HashString(CLAY_STRING("Text"), parentElement->childrenOrTextContent.children.length, parentElement->id);
     openLayoutElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, openLayoutElement);
-    Clay__StringArray_Add(&Clay__layoutElementIdStrings, elementId.stringId);
+    Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
     Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? textConfig->lineHeight : textMeasured->unwrappedDimensions.height };
     openLayoutElement->dimensions = textDimensions;
     openLayoutElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->unwrappedDimensions.height, .height = textDimensions.height }; // TODO not sure this is the best way to decide min width for text
-    openLayoutElement->childrenOrTextContent.textElementData = Clay__TextElementDataArray_Add(&Clay__textElementData, CLAY__INIT(Clay__TextElementData) { .text = text, .preferredDimensions = textMeasured->unwrappedDimensions, .elementIndex = Clay__layoutElements.length - 1 });
+    openLayoutElement->childrenOrTextContent.textElementData = Clay__TextElementDataArray_Add(&context->textElementData, CLAY__INIT(Clay__TextElementData) { .text = text, .preferredDimensions = textMeasured->unwrappedDimensions, .elementIndex = context->layoutElements.length - 1 });
     openLayoutElement->elementConfigs = CLAY__INIT(Clay__ElementConfigArraySlice) {
         .length = 1,
-        .internalArray = Clay__ElementConfigArray_Add(&Clay__elementConfigs, CLAY__INIT(Clay_ElementConfig) { .type = CLAY__ELEMENT_CONFIG_TYPE_TEXT, .config = { .textElementConfig = textConfig }})
+        .internalArray = Clay__ElementConfigArray_Add(&context->elementConfigs, CLAY__INIT(Clay_ElementConfig) { .type = CLAY__ELEMENT_CONFIG_TYPE_TEXT, .config = { .textElementConfig = textConfig }})
     };
     openLayoutElement->configsEnabled |= CLAY__ELEMENT_CONFIG_TYPE_TEXT;
     openLayoutElement->layoutConfig = &CLAY_LAYOUT_DEFAULT;
+    if (context->incrementalLayoutEnabled) {
+        Clay__UpdateLayoutCacheHash(openLayoutElement);
+    }
     // Close the currently open element
-    Clay__int32_tArray_RemoveSwapback(&Clay__openLayoutElementStack, (int)Clay__openLayoutElementStack.length - 1);
+    Clay__int32_tArray_RemoveSwapback(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1);
 }
 
-void Clay__InitializeEphemeralMemory(Clay_Arena *arena) {
+// Text declared while measurements were batched was given placeholder sizes. Once the batch has been measured the text
+// elements are resized, and every container is refit to its children, visiting children before their parents.
+void Clay__ResolveMeasureTextBatch(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__FlushMeasureTextBatch();
+    if (!context->measureTextBatchPending) {
+        return;
+    }
+    context->measureTextBatchPending = false;
+    for (uint32_t i = 0; i < context->textElementData.length; ++i) {
+        Clay__TextElementData *textElementData = &context->textElementData.internalArray[i];
+        Clay_LayoutElement *textElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)textElementData->elementIndex);
+        Clay_TextElementConfig *textConfig = Clay__FindElementConfigWithType(textElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig;
+        Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&textElementData->text, textConfig);
+        Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? textConfig->lineHeight : textMeasured->unwrappedDimensions.height };
+        textElement->dimensions = textDimensions;
+        textElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->unwrappedDimensions.height, .height = textDimensions.height };
+        textElementData->preferredDimensions = textMeasured->unwrappedDimensions;
+    }
+    for (int32_t i = (int32_t)context->layoutElements.length - 1; i >= 0; --i) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[i];
+        if (!Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            Clay__CalculateFitDimensions(layoutElement);
+        }
+    }
+}
+
+uint32_t Clay__ElementCategoryCapacity(Clay_Context* context, uint32_t maxCategoryCount) {
+    return maxCategoryCount > 0 && maxCategoryCount < context->maxElementCount ? maxCategoryCount : context->maxElementCount;
+}
+
+void Clay__InitializeEphemeralMemory(Clay_Context* context) {
+    Clay_Arena *arena = &context->internalArena;
+    uint32_t maxTextElementCount = Clay__ElementCategoryCapacity(context, context->maxTextElementCount);
+    uint32_t maxImageElementCount = Clay__ElementCategoryCapacity(context, context->maxImageElementCount);
+    uint32_t maxFloatingElementCount = Clay__ElementCategoryCapacity(context, context->maxFloatingElementCount);
     // Ephemeral Memory - reset every frame
-    Clay__internalArena.nextAllocation = Clay__arenaResetOffset;
-
-    Clay__layoutElementChildrenBuffer = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__layoutElements = Clay_LayoutElementArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay_warnings = Clay__WarningArray_Allocate_Arena(100, arena);
-
-    Clay__layoutConfigs = Clay__LayoutConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__elementConfigBuffer = Clay__ElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__elementConfigs = Clay__ElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__rectangleElementConfigs = Clay__RectangleElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__textElementConfigs = Clay__TextElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__imageElementConfigs = Clay__ImageElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__floatingElementConfigs = Clay__FloatingElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__scrollElementConfigs = Clay__ScrollElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__customElementConfigs = Clay__CustomElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__borderElementConfigs = Clay__BorderElementConfigArray_Allocate_Arena(Clay__maxElementCount, arena);
-
-    Clay__layoutElementIdStrings = Clay__StringArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__layoutElementTreeNodeArray1 = Clay__LayoutElementTreeNodeArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__layoutElementChildren = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__openLayoutElementStack = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__textElementData = Clay__TextElementDataArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__imageElementPointers = Clay__LayoutElementPointerArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__renderCommands = Clay_RenderCommandArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__treeNodeVisited = Clay__BoolArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__treeNodeVisited.length = Clay__treeNodeVisited.capacity; // This array is accessed directly rather than behaving as a list
-    Clay__openClipElementStack = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__dynamicStringData = Clay__CharArray_Allocate_Arena(Clay__maxElementCount, arena);
-}
-
-void Clay__InitializePersistentMemory(Clay_Arena *arena) {
+    arena->nextAllocation = context->arenaResetOffset;
+
+    context->layoutElementChildrenBuffer = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->layoutElements = Clay_LayoutElementArray_Allocate_Arena(context->maxElementCount, arena);
+    context->warnings = Clay__WarningArray_Allocate_Arena(100, arena);
+
+    context->layoutConfigs = Clay__LayoutConfigArray_Allocate_Arena(context->maxElementCount, arena);
+    context->elementConfigBuffer = Clay__ElementConfigArray_Allocate_Arena(context->maxElementCount, arena);
+    context->elementConfigs = Clay__ElementConfigArray_Allocate_Arena(context->maxElementCount, arena);
+    context->rectangleElementConfigs = Clay__RectangleElementConfigArray_Allocate_Arena(context->maxElementCount, arena);
+    context->textElementConfigs = Clay__TextElementConfigArray_Allocate_Arena(maxTextElementCount, arena);
+    context->imageElementConfigs = Clay__ImageElementConfigArray_Allocate_Arena(maxImageElementCount, arena);
+    // Floating elements without a parent id store a second copy of their config with the parent id filled in
+    context->floatingElementConfigs = Clay__FloatingElementConfigArray_Allocate_Arena(maxFloatingElementCount * 2, arena);
+    context->scrollElementConfigs = Clay__ScrollElementConfigArray_Allocate_Arena(CLAY__MIN(context->maxScrollContainerCount, context->maxElementCount), arena);
+    context->customElementConfigs = Clay__CustomElementConfigArray_Allocate_Arena(Clay__ElementCategoryCapacity(context, context->maxCustomElementCount), arena);
+    context->borderElementConfigs = Clay__BorderElementConfigArray_Allocate_Arena(Clay__ElementCategoryCapacity(context, context->maxBorderElementCount), arena);
+    context->configInternTable = Clay__ConfigInternSlotArray_Allocate_Arena(CLAY__CONFIG_INTERN_TABLE_SIZE, arena);
+
+    context->layoutElementIdStrings = Clay__StringArray_Allocate_Arena(context->maxElementCount, arena);
+    context->wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(context->maxElementCount, arena);
+    context->layoutElementTreeNodeArray1 = Clay__LayoutElementTreeNodeArray_Allocate_Arena(context->maxElementCount, arena);
+    // One tree root for each floating element, plus the root element of the layout
+    context->layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxFloatingElementCount + 1, arena);
+    context->hitTestNodes = Clay__HitTestNodeArray_Allocate_Arena(context->maxElementCount, arena);
+    context->layoutElementChildren = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->openLayoutElementStack = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->textElementData = Clay__TextElementDataArray_Allocate_Arena(maxTextElementCount, arena);
+    context->imageElementPointers = Clay__LayoutElementPointerArray_Allocate_Arena(maxImageElementCount, arena);
+    context->renderCommands = Clay_RenderCommandArray_Allocate_Arena(context->maxElementCount, arena);
+    context->treeNodeVisited = Clay__BoolArray_Allocate_Arena(context->maxElementCount, arena);
+    context->treeNodeVisited.length = context->treeNodeVisited.capacity; // This array is accessed directly rather than behaving as a list
+    context->openClipElementStack = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->sizeDistributionBuffer = Clay__floatArray_Allocate_Arena(context->maxElementCount * 2, arena);
+    context->layoutElementAxisData = CLAY__INIT(Clay__LayoutElementAxisData) {
+        .sizes = Clay__floatArray_Allocate_Arena(context->maxElementCount, arena),
+        .minSizes = Clay__floatArray_Allocate_Arena(context->maxElementCount, arena),
+        .sizingMins = Clay__floatArray_Allocate_Arena(context->maxElementCount, arena),
+        .sizingMaxes = Clay__floatArray_Allocate_Arena(context->maxElementCount, arena),
+        .paddings = Clay__floatArray_Allocate_Arena(context->maxElementCount, arena),
+        .childGaps = Clay__floatArray_Allocate_Arena(context->maxElementCount, arena),
+        .sizingTypes = Clay__uint8_tArray_Allocate_Arena(context->maxElementCount, arena),
+        .flags = Clay__uint8_tArray_Allocate_Arena(context->maxElementCount, arena),
+        .firstChildOffsets = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena),
+        .childCounts = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena),
+    };
+    context->cullingRectangles = Clay_BoundingBoxArray_Allocate_Arena(context->maxScrollContainerCount + 1, arena);
+    context->reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->dynamicStringData = Clay__CharArray_Allocate_Arena(context->maxElementCount, arena);
+    context->damageRectangles = Clay_BoundingBoxArray_Allocate_Arena(16, arena);
+    context->measureTextBatchItems = Clay__MeasureTextBatchItemArray_Allocate_Arena(CLAY__MEASURE_TEXT_BATCH_SIZE, arena);
+    context->measureTextBatchTargets = Clay__MeasureTextBatchTargetArray_Allocate_Arena(CLAY__MEASURE_TEXT_BATCH_SIZE, arena);
+    context->measureTextBatchSlots = Clay__MeasureTextBatchSlotArray_Allocate_Arena(CLAY__MEASURE_TEXT_BATCH_SIZE * 2, arena);
+    context->measureTextBatchDimensions = Clay__DimensionsArray_Allocate_Arena(CLAY__MEASURE_TEXT_BATCH_SIZE, arena);
+}
+
+void Clay__InitializePersistentMemory(Clay_Context* context) {
+    Clay_Arena *arena = &context->internalArena;
     // Persistent memory - initialized once and not reset
-    Clay__scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(10, arena);
-    Clay__layoutElementsHashMapInternal = Clay__LayoutElementHashMapItemArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__layoutElementsHashMap = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__measureTextHashMapInternal = Clay__MeasureTextCacheItemArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__measureTextHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__measuredWordsFreeList = Clay__int32_tArray_Allocate_Arena(Clay__maxMeasureTextCacheWordCount, arena);
-    Clay__measureTextHashMap = Clay__int32_tArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__measuredWords = Clay__MeasuredWordArray_Allocate_Arena(Clay__maxMeasureTextCacheWordCount, arena);
-    Clay__pointerOverIds = Clay__ElementIdArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__debugElementData = Clay__DebugElementDataArray_Allocate_Arena(Clay__maxElementCount, arena);
-    Clay__arenaResetOffset = arena->nextAllocation;
+    context->scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(context->maxScrollContainerCount, arena);
+    context->glyphAdvanceTables = Clay__GlyphAdvanceTableEntryArray_Allocate_Arena(64, arena);
+    context->persistedConfigs = Clay__PersistedConfigArray_Allocate_Arena(context->maxPersistedConfigCount, arena);
+    uint32_t persistedConfigIndexCapacity = 1;
+    while (persistedConfigIndexCapacity < context->maxPersistedConfigCount * 2) {
+        persistedConfigIndexCapacity *= 2;
+    }
+    context->persistedConfigIndices = Clay__int32_tArray_Allocate_Arena(persistedConfigIndexCapacity, arena);
+    uint32_t scrollIndexCapacity = 1;
+    while (scrollIndexCapacity < context->maxScrollContainerCount * 2) {
+        scrollIndexCapacity *= 2;
+    }
+    context->scrollContainerDataIndices = Clay__int32_tArray_Allocate_Arena(scrollIndexCapacity, arena);
+    context->layoutElementsHashMapInternal = Clay__LayoutElementHashMapItemArray_Allocate_Arena(context->maxElementCount, arena);
+    uint32_t hashMapCapacity = 1;
+    while (hashMapCapacity < context->maxElementCount * 2) {
+        hashMapCapacity *= 2;
+    }
+    // Aligned to the cache line so that no slot straddles two lines
+    context->layoutElementsHashMap = CLAY__INIT(Clay__LayoutElementHashMapSlotArray) { .capacity = hashMapCapacity, .internalArray = (Clay__LayoutElementHashMapSlot *)Clay__Array_Allocate_Arena(hashMapCapacity, sizeof(Clay__LayoutElementHashMapSlot), 64, arena) };
+    context->measureTextHashMapInternal = Clay__MeasureTextCacheItemArray_Allocate_Arena(context->maxElementCount, arena);
+    context->measureTextHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->measuredWordOwners = Clay__int32_tArray_Allocate_Arena(context->maxMeasureTextCacheWordCount, arena);
+    context->measureTextHashMap = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->measuredWords = Clay__MeasuredWordArray_Allocate_Arena(context->maxMeasureTextCacheWordCount, arena);
+    // Only distinct words are stored, which are far fewer than the words of every measured string, and the cache starts over
+    // when it fills up rather than failing, so it doesn't need to hold as many words as measuredWords
+    uint32_t wordCacheCapacity = 1;
+    while (wordCacheCapacity < context->maxMeasureTextCacheWordCount / 2) {
+        wordCacheCapacity *= 2;
+    }
+    context->measuredWordCache = Clay__MeasuredWordCacheEntryArray_Allocate_Arena(wordCacheCapacity, arena);
+    context->pointerOverIds = Clay__ElementIdArray_Allocate_Arena(context->maxElementCount, arena);
+    context->debugElementData = Clay__DebugElementDataArray_Allocate_Arena(context->maxElementCount, arena);
+    context->arenaResetOffset = arena->nextAllocation;
+}
+
+// Optional features allocate their memory from the end of the arena the first time they are used, so that contexts which
+// never use them don't need the space. The capacity of the arena is lowered to the start of that memory so that ephemeral
+// memory, which is reset every frame, can't grow into it.
+bool Clay__AllocateOptionalFeatureMemory(Clay_Context* context, void (*initializeMemory)(Clay_Context* context, Clay_Arena *arena), Clay_String errorText) {
+    Clay_Arena *arena = &context->internalArena;
+    // Measured from a cache line boundary, which is also where the real allocation starts, so alignment padding is the same
+    Clay_Context measureContext = *context;
+    Clay_Arena measureArena = { .capacity = SIZE_MAX };
+    initializeMemory(&measureContext, &measureArena);
+    uintptr_t arenaStart = (uintptr_t)arena->memory;
+    uintptr_t arenaEnd = arenaStart + arena->capacity;
+    uintptr_t featureStart = (arenaEnd - measureArena.nextAllocation) & ~(uintptr_t)63;
+    if (measureArena.nextAllocation > arena->capacity || featureStart < arenaStart + arena->nextAllocation) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
+            .errorText = errorText,
+            .userData = context->errorHandler.userData });
+        return false;
+    }
+    Clay_Arena featureArena = { .nextAllocation = featureStart - arenaStart, .capacity = arena->capacity, .memory = arena->memory };
+    initializeMemory(context, &featureArena);
+    arena->capacity = featureStart - arenaStart;
+    return true;
+}
+
+void Clay__InitializeLayoutCacheMemory(Clay_Context* context, Clay_Arena *arena) {
+    context->layoutCaches = Clay__LayoutCacheDataArray_Allocate_Arena(context->maxElementCount, arena);
+    context->cachedTextLines = Clay__CachedTextLineArray_Allocate_Arena(context->maxElementCount, arena);
+    context->previousCachedTextLines = Clay__CachedTextLineArray_Allocate_Arena(context->maxElementCount, arena);
+}
+
+void Clay__InitializeWrappedTextCacheMemory(Clay_Context* context, Clay_Arena *arena) {
+    context->wrappedLinesCacheEntries = Clay__WrappedLinesCacheEntryArray_Allocate_Arena(context->maxElementCount, arena);
+    context->wrappedLineCache = Clay__CachedTextLineArray_Allocate_Arena(context->maxElementCount, arena);
+    context->previousWrappedLineCache = Clay__CachedTextLineArray_Allocate_Arena(context->maxElementCount, arena);
+}
+
+void Clay__InitializeRenderCommandBatchMemory(Clay_Context* context, Clay_Arena *arena) {
+    context->renderCommandBatchItems = Clay__RenderCommandBatchItemArray_Allocate_Arena(context->maxElementCount, arena);
+    context->renderCommandBatchScratch = Clay__RenderCommandBatchItemArray_Allocate_Arena(context->maxElementCount, arena);
+}
+
+void Clay__InitializeRenderCommandDiffMemory(Clay_Context* context, Clay_Arena *arena) {
+    context->renderCommandDiffItems = Clay__RenderCommandDiffItemArray_Allocate_Arena(context->maxElementCount, arena);
+    context->previousRenderCommandDiffItems = Clay__RenderCommandDiffItemArray_Allocate_Arena(context->maxElementCount, arena);
+    context->renderCommandDiffSlots = Clay__RenderCommandDiffSlotArray_Allocate_Arena(context->maxElementCount * 2, arena);
+    context->renderCommandDiffNextIndices = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->renderCommandDiffStatuses = Clay__int32_tArray_Allocate_Arena(context->maxElementCount, arena);
+    context->renderCommandDiffs = Clay_RenderCommandArray_Allocate_Arena(context->maxElementCount * 2, arena);
 }
 
 
+// The buffers used while sizing one layout tree root. Roots that are sized in parallel are each given their own slice of
+// the shared buffers, large enough for the number of elements in their tree.
+CLAY__TYPEDEF(Clay__SizingScratch, struct {
+    Clay__int32_tArray bfsBuffer;
+    Clay__int32_tArray resizableContainerBuffer;
+    Clay__int32_tArray remainingElements;
+    Clay__floatArray breakpoints;
+});
+
+Clay__SizingScratch Clay__SizingScratchSlice(uint32_t offset, uint32_t elementCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return CLAY__INIT(Clay__SizingScratch) {
+        .bfsBuffer = CLAY__INIT(Clay__int32_tArray) { .capacity = elementCount, .length = 0, .internalArray = context->layoutElementChildrenBuffer.internalArray + offset },
+        .resizableContainerBuffer = CLAY__INIT(Clay__int32_tArray) { .capacity = elementCount, .length = 0, .internalArray = context->openLayoutElementStack.internalArray + offset },
+        .remainingElements = CLAY__INIT(Clay__int32_tArray) { .capacity = elementCount, .length = 0, .internalArray = context->openClipElementStack.internalArray + offset },
+        .breakpoints = CLAY__INIT(Clay__floatArray) { .capacity = elementCount * 2, .length = 0, .internalArray = context->sizeDistributionBuffer.internalArray + offset * 2 },
+    };
+}
+
 CLAY__TYPEDEF(Clay__SizeDistributionType, enum {
     CLAY__SIZE_DISTRIBUTION_TYPE_SCROLL_CONTAINER,
     CLAY__SIZE_DISTRIBUTION_TYPE_RESIZEABLE_CONTAINER,
     CLAY__SIZE_DISTRIBUTION_TYPE_GROW_CONTAINER,
 });
 
-float Clay__DistributeSizeAmongChildren(bool xAxis, float sizeToDistribute, Clay__int32_tArray resizableContainerBuffer, Clay__SizeDistributionType distributionType) {
-    Clay__int32_tArray remainingElements = Clay__openClipElementStack;
+void Clay__SiftFloatDown(float *values, int32_t root, int32_t count) {
+    while (root * 2 + 1 < count) {
+        int32_t child = root * 2 + 1;
+        if (child + 1 < count && values[child] < values[child + 1]) {
+            child++;
+        }
+        if (values[root] >= values[child]) {
+            return;
+        }
+        float swap = values[root];
+        values[root] = values[child];
+        values[child] = swap;
+        root = child;
+    }
+}
+
+// In place heap sort into ascending order
+void Clay__SortFloats(float *values, int32_t count) {
+    for (int32_t root = count / 2 - 1; root >= 0; --root) {
+        Clay__SiftFloatDown(values, root, count);
+    }
+    for (int32_t end = count - 1; end > 0; --end) {
+        float swap = values[0];
+        values[0] = values[end];
+        values[end] = swap;
+        Clay__SiftFloatDown(values, 0, end);
+    }
+}
+
+float Clay__DistributedChildSize(int32_t childElementIndex, float offset) {
+    Clay__LayoutElementAxisData *axisData = &Clay_GetCurrentContext()->layoutElementAxisData;
+    float childSize = axisData->sizes.internalArray[childElementIndex];
+    return CLAY__MAX(CLAY__MAX(CLAY__MIN(axisData->sizingMaxes.internalArray[childElementIndex], childSize + offset), axisData->sizingMins.internalArray[childElementIndex]), axisData->minSizes.internalArray[childElementIndex]);
+}
+
+// Every child that can take part is first given an even share clamped to its own limits, which also snaps children that
+// start outside their limits back inside them. What is left is then shared by offsetting every child that moved by the
+// same amount, clamped to its limits (water filling). A child's size only follows the offset between its low and high
+// breakpoints, so sweeping both sets of breakpoints in sorted order while tracking how many children are still following
+// finds that offset in one pass. Returns the size that couldn't be distributed.
+float Clay__DistributeSizeAmongChildren(bool xAxis, float sizeToDistribute, Clay__int32_tArray resizableContainerBuffer, Clay__SizeDistributionType distributionType, Clay__SizingScratch *scratch) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementAxisData *axisData = &context->layoutElementAxisData;
+    float *sizes = axisData->sizes.internalArray;
+    Clay__int32_tArray remainingElements = scratch->remainingElements;
     remainingElements.length = 0;
 
+    if (sizeToDistribute == 0) {
+        return 0;
+    }
+
     for (uint32_t i = 0; i < resizableContainerBuffer.length; ++i) {
-        Clay__int32_tArray_Add(&remainingElements, Clay__int32_tArray_Get(&resizableContainerBuffer, i));
+        int32_t childElementIndex = Clay__int32_tArray_Get(&resizableContainerBuffer, i);
+        uint8_t childFlags = axisData->flags.internalArray[childElementIndex];
+        float childSize = sizes[childElementIndex];
+
+        if ((sizeToDistribute < 0 && childSize == axisData->sizingMins.internalArray[childElementIndex]) || (sizeToDistribute > 0 && childSize == axisData->sizingMaxes.internalArray[childElementIndex])) {
+            continue;
+        }
+        // Currently, we don't support squishing aspect ratio images on their Y axis as it would break ratio
+        if (!xAxis && (childFlags & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_IMAGE)) {
+            continue;
+        }
+        switch (distributionType) {
+            case CLAY__SIZE_DISTRIBUTION_TYPE_RESIZEABLE_CONTAINER: break;
+            case CLAY__SIZE_DISTRIBUTION_TYPE_GROW_CONTAINER: if (axisData->sizingTypes.internalArray[childElementIndex] != CLAY__SIZING_TYPE_GROW) continue; break;
+            case CLAY__SIZE_DISTRIBUTION_TYPE_SCROLL_CONTAINER: {
+                if ((childFlags & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLL_CONTAINER) && !(childFlags & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLLS_ALONG_AXIS)) {
+                    continue;
+                }
+            }
+        }
+        Clay__int32_tArray_Add(&remainingElements, childElementIndex);
+    }
+
+    uint32_t count = remainingElements.length;
+    if (count > 0) {
+        // The share is divided between every child in the buffer, including those that can't take part, as it always has been.
+        // Children it doesn't move drop out, and what they did move isn't counted.
+        float dividedSize = sizeToDistribute / (float)resizableContainerBuffer.length;
+        uint32_t movedCount = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            int32_t childElementIndex = remainingElements.internalArray[i];
+            float newChildSize = Clay__DistributedChildSize(childElementIndex, dividedSize);
+            float diff = newChildSize - sizes[childElementIndex];
+            sizes[childElementIndex] = newChildSize;
+            if (diff > -0.01 && diff < 0.01) {
+                continue;
+            }
+            sizeToDistribute -= diff;
+            remainingElements.internalArray[movedCount++] = childElementIndex;
+        }
+        count = sizeToDistribute != 0 ? movedCount : 0;
+    }
+    if (count > 0) {
+        // Every child is now within its limits, so its low breakpoint is at or below zero and its high breakpoint at or above.
+        // Low breakpoints are stored in the first half of the buffer and high breakpoints in the second half
+        float *lowBreakpoints = scratch->breakpoints.internalArray;
+        float *highBreakpoints = lowBreakpoints + count;
+        float totalChange = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            int32_t childElementIndex = remainingElements.internalArray[i];
+            float childSize = sizes[childElementIndex];
+            lowBreakpoints[i] = CLAY__MAX(axisData->sizingMins.internalArray[childElementIndex], axisData->minSizes.internalArray[childElementIndex]) - childSize;
+            highBreakpoints[i] = CLAY__MAX(axisData->sizingMaxes.internalArray[childElementIndex] - childSize, lowBreakpoints[i]);
+            totalChange += lowBreakpoints[i];
+        }
+        Clay__SortFloats(lowBreakpoints, (int32_t)count);
+        Clay__SortFloats(highBreakpoints, (int32_t)count);
+
+        // Below the lowest breakpoint every child is clamped to its low end, so the sweep starts there
+        float offset = lowBreakpoints[0];
+        uint32_t followingCount = 0;
+        uint32_t lowIndex = 0, highIndex = 0;
+        while (totalChange < sizeToDistribute && highIndex < count) {
+            bool isLowBreakpoint = lowIndex < count && lowBreakpoints[lowIndex] <= highBreakpoints[highIndex];
+            float nextOffset = isLowBreakpoint ? lowBreakpoints[lowIndex] : highBreakpoints[highIndex];
+            float nextChange = totalChange + (float)followingCount * (nextOffset - offset);
+            if (nextChange >= sizeToDistribute) {
+                offset += (sizeToDistribute - totalChange) / (float)followingCount;
+                break;
+            }
+            totalChange = nextChange;
+            offset = nextOffset;
+            if (isLowBreakpoint) {
+                followingCount++;
+                lowIndex++;
+            } else {
+                followingCount--;
+                highIndex++;
+            }
+        }
+        offset = sizeToDistribute < 0 ? CLAY__MIN(offset, 0) : CLAY__MAX(offset, 0);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            int32_t childElementIndex = remainingElements.internalArray[i];
+            float newChildSize = Clay__DistributedChildSize(childElementIndex, offset);
+            sizeToDistribute -= newChildSize - sizes[childElementIndex];
+            sizes[childElementIndex] = newChildSize;
+        }
+    }
+    return (sizeToDistribute > -0.01 && sizeToDistribute < 0.01) ? 0 : sizeToDistribute;
+}
+
+bool Clay__LayoutCacheRestored(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->incrementalLayoutEnabled && layoutElement->layoutCache && layoutElement->layoutCache->restored;
+}
+
+// If an element's subtree hasn't changed since the previous frame and the element has been given the same size along this axis,
+// the previous frame's results are copied to its descendants instead of being recalculated. Returns true if they were restored.
+bool Clay__RestoreCachedLayout(Clay_LayoutElement *layoutElement, bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutCacheData *layoutCache = layoutElement->layoutCache;
+    if (!layoutCache || !layoutCache->subtreeUnchanged || layoutElement->childrenOrTextContent.children.length == 0) {
+        return false;
+    }
+    if (xAxis) {
+        if (layoutElement->dimensions.width != layoutCache->dimensions.width) {
+            return false;
+        }
+    } else {
+        // Heights can only be restored if the descendants' widths were restored as well
+        Clay_LayoutElement *firstChild = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[0]);
+        if (!firstChild->layoutCache || !firstChild->layoutCache->restored || layoutElement->dimensions.height != layoutCache->dimensions.height) {
+            return false;
+        }
     }
-
-    while (sizeToDistribute != 0 && remainingElements.length > 0) {
-        float dividedSize = sizeToDistribute / (float)remainingElements.length;
-        for (uint32_t childOffset = 0; childOffset < remainingElements.length; childOffset++) {
-            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&remainingElements, childOffset));
-            Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-            float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-            float childMinSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
-            bool canDistribute = true;
-
-            if ((sizeToDistribute < 0 && *childSize == childSizing.size.minMax.min) || (sizeToDistribute > 0 && *childSize == childSizing.size.minMax.max)) {
-                canDistribute = false;
-            }
-            // Currently, we don't support squishing aspect ratio images on their Y axis as it would break ratio
-            else if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
-                canDistribute = false;
-            }
-            else {
-                switch (distributionType) {
-                    case CLAY__SIZE_DISTRIBUTION_TYPE_RESIZEABLE_CONTAINER: break;
-                    case CLAY__SIZE_DISTRIBUTION_TYPE_GROW_CONTAINER: if (childSizing.type != CLAY__SIZING_TYPE_GROW) canDistribute = false; break;
-                    case CLAY__SIZE_DISTRIBUTION_TYPE_SCROLL_CONTAINER: {
-                        if (Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                            Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(childElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                            if ((xAxis && !scrollConfig->horizontal) || (!xAxis && !scrollConfig->vertical)) {
-                                Clay__int32_tArray_RemoveSwapback(&remainingElements, childOffset);
-                                childOffset--;
-                                continue;
-                            }
-                        }
+    Clay__int32_tArray dfsBuffer = context->reusableElementIndexBuffer;
+    dfsBuffer.length = 0;
+    for (int i = 0; i < layoutElement->childrenOrTextContent.children.length; ++i) {
+        Clay__int32_tArray_Add(&dfsBuffer, layoutElement->childrenOrTextContent.children.elements[i]);
+    }
+    while (dfsBuffer.length > 0) {
+        Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_RemoveSwapback(&dfsBuffer, (int)dfsBuffer.length - 1));
+        Clay__LayoutCacheData *currentCache = currentElement->layoutCache;
+        bool isText = Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT);
+        if (xAxis) {
+            currentElement->dimensions.width = currentCache->dimensions.width;
+            currentElement->dimensions.height = currentCache->contentHeight;
+            currentCache->restored = true;
+            if (isText) {
+                Clay__TextElementData *textElementData = currentElement->childrenOrTextContent.textElementData;
+                textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &context->wrappedTextLines.internalArray[context->wrappedTextLines.length] };
+                for (uint32_t j = 0; j < currentCache->wrappedLinesCount; ++j) {
+                    if (context->wrappedTextLines.length > context->wrappedTextLines.capacity - 1) {
+                        break;
                     }
+                    Clay__CachedTextLine *cachedLine = Clay__CachedTextLineArray_Get(&context->previousCachedTextLines, currentCache->wrappedLinesStartIndex + j);
+                    Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { cachedLine->dimensions, { .length = cachedLine->length, .chars = &textElementData->text.chars[cachedLine->startOffset] } });
+                    textElementData->wrappedLines.length++;
                 }
             }
-
-            if (!canDistribute) {
-                Clay__int32_tArray_RemoveSwapback(&remainingElements, childOffset);
-                childOffset--;
-                continue;
+        } else {
+            currentElement->dimensions.height = currentCache->dimensions.height;
+        }
+        if (!isText) {
+            for (int i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
+                Clay__int32_tArray_Add(&dfsBuffer, currentElement->childrenOrTextContent.children.elements[i]);
             }
+        }
+    }
+    return true;
+}
 
-            float oldChildSize = *childSize;
-            *childSize = CLAY__MAX(CLAY__MAX(CLAY__MIN(childSizing.size.minMax.max, *childSize + dividedSize), childSizing.size.minMax.min), childMinSize);
-            float diff = *childSize - oldChildSize;
-            if (diff > -0.01 && diff < 0.01) {
-                Clay__int32_tArray_RemoveSwapback(&remainingElements, childOffset);
-                childOffset--;
+// Stores the results of the sizing passes so that unchanged subtrees can be restored next frame
+void Clay__StoreLayoutCache(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (uint32_t i = 0; i < context->layoutElements.length; ++i) {
+        Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, i);
+        Clay__LayoutCacheData *layoutCache = layoutElement->layoutCache;
+        if (!layoutCache) {
+            continue;
+        }
+        layoutCache->layoutHash = layoutElement->layoutHash;
+        layoutCache->dimensions = layoutElement->dimensions;
+        layoutCache->validGeneration = context->generation + 1;
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            Clay__TextElementData *textElementData = layoutElement->childrenOrTextContent.textElementData;
+            layoutCache->wrappedLinesStartIndex = (int32_t)context->cachedTextLines.length;
+            layoutCache->wrappedLinesCount = textElementData->wrappedLines.length;
+            if (context->cachedTextLines.length + textElementData->wrappedLines.length > context->cachedTextLines.capacity) {
+                layoutCache->validGeneration = 0; // Out of space, the element will be recalculated next frame
                 continue;
             }
-            sizeToDistribute -= diff;
+            for (uint32_t j = 0; j < textElementData->wrappedLines.length; ++j) {
+                Clay__WrappedTextLine *wrappedLine = &textElementData->wrappedLines.internalArray[j];
+                Clay__CachedTextLineArray_Add(&context->cachedTextLines, CLAY__INIT(Clay__CachedTextLine) { wrappedLine->dimensions, (uint32_t)(wrappedLine->line.chars - textElementData->text.chars), (uint32_t)wrappedLine->line.length });
+            }
         }
     }
-    return (sizeToDistribute > -0.01 && sizeToDistribute < 0.01) ? 0 : sizeToDistribute;
 }
 
-void Clay__SizeContainersAlongAxis(bool xAxis) {
-    Clay__int32_tArray bfsBuffer = Clay__layoutElementChildrenBuffer;
-    Clay__int32_tArray resizableContainerBuffer = Clay__openLayoutElementStack;
-    for (uint32_t rootIndex = 0; rootIndex < Clay__layoutElementTreeRoots.length; ++rootIndex) {
-        bfsBuffer.length = 0;
-        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&Clay__layoutElementTreeRoots, rootIndex);
-        Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, (int)root->layoutElementIndex);
-        Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
-
-        // Size floating containers to their parents
-        if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER)) {
-            Clay_FloatingElementConfig *floatingElementConfig = Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER).floatingElementConfig;
-            Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingElementConfig->parentId);
-            if (parentItem) {
-                Clay_LayoutElement *parentLayoutElement = parentItem->layoutElement;
-                if (rootElement->layoutConfig->sizing.width.type == CLAY__SIZING_TYPE_GROW) {
-                    rootElement->dimensions.width = parentLayoutElement->dimensions.width;
-                }
-                if (rootElement->layoutConfig->sizing.height.type == CLAY__SIZING_TYPE_GROW) {
-                    rootElement->dimensions.height = parentLayoutElement->dimensions.height;
-                }
+// Gathers the fields used to size elements along one axis into layoutElementAxisData
+void Clay__PrepareLayoutElementAxisData(bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementAxisData *axisData = &context->layoutElementAxisData;
+    uint32_t elementCount = context->layoutElements.length;
+    for (uint32_t i = 0; i < elementCount; ++i) {
+        Clay_LayoutElement *element = Clay_LayoutElementArray_Get(&context->layoutElements, (int)i);
+        Clay_LayoutConfig *layoutConfig = element->layoutConfig;
+        Clay_SizingAxis sizing = xAxis ? layoutConfig->sizing.width : layoutConfig->sizing.height;
+        bool isText = Clay__ElementHasConfig(element, CLAY__ELEMENT_CONFIG_TYPE_TEXT);
+        uint8_t flags = 0;
+        if (!isText && element->childrenOrTextContent.children.length > 0) {
+            flags |= CLAY__LAYOUT_ELEMENT_AXIS_FLAG_HAS_CHILDREN;
+        }
+        if (sizing.type != CLAY__SIZING_TYPE_PERCENT && sizing.type != CLAY__SIZING_TYPE_FIXED && (!isText || (Clay__FindElementConfigWithType(element, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig->wrapMode == CLAY_TEXT_WRAP_WORDS))) {
+            flags |= CLAY__LAYOUT_ELEMENT_AXIS_FLAG_RESIZABLE;
+        }
+        if (Clay__ElementHasConfig(element, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
+            flags |= CLAY__LAYOUT_ELEMENT_AXIS_FLAG_IMAGE;
+        }
+        if (Clay__ElementHasConfig(element, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+            Clay_ScrollElementConfig *scrollElementConfig = Clay__FindElementConfigWithType(element, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+            flags |= CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLL_CONTAINER;
+            if ((xAxis && scrollElementConfig->horizontal) || (!xAxis && scrollElementConfig->vertical)) {
+                flags |= CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLLS_ALONG_AXIS;
+            }
+        }
+        if ((xAxis && layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM)) {
+            flags |= CLAY__LAYOUT_ELEMENT_AXIS_FLAG_LAYOUT_ALONG_AXIS;
+        }
+        axisData->sizes.internalArray[i] = xAxis ? element->dimensions.width : element->dimensions.height;
+        axisData->minSizes.internalArray[i] = xAxis ? element->minDimensions.width : element->minDimensions.height;
+        axisData->sizingMins.internalArray[i] = sizing.size.minMax.min;
+        axisData->sizingMaxes.internalArray[i] = sizing.size.minMax.max;
+        axisData->paddings.internalArray[i] = (float)(xAxis ? layoutConfig->padding.x : layoutConfig->padding.y);
+        axisData->childGaps.internalArray[i] = (float)layoutConfig->childGap;
+        axisData->sizingTypes.internalArray[i] = (uint8_t)sizing.type;
+        axisData->flags.internalArray[i] = flags;
+        axisData->firstChildOffsets.internalArray[i] = isText ? 0 : (int32_t)(element->childrenOrTextContent.children.elements - context->layoutElementChildren.internalArray);
+        axisData->childCounts.internalArray[i] = isText ? 0 : element->childrenOrTextContent.children.length;
+    }
+    axisData->sizes.length = axisData->minSizes.length = axisData->sizingMins.length = axisData->sizingMaxes.length = elementCount;
+    axisData->paddings.length = axisData->childGaps.length = axisData->sizingTypes.length = axisData->flags.length = elementCount;
+    axisData->firstChildOffsets.length = axisData->childCounts.length = elementCount;
+}
+
+void Clay__SizeLayoutElementTreeRoot(bool xAxis, uint32_t rootIndex, Clay__SizingScratch scratch) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__int32_tArray bfsBuffer = scratch.bfsBuffer;
+    Clay__int32_tArray resizableContainerBuffer = scratch.resizableContainerBuffer;
+    Clay__LayoutElementAxisData *axisData = &context->layoutElementAxisData;
+    float *sizes = axisData->sizes.internalArray;
+    uint8_t *sizingTypes = axisData->sizingTypes.internalArray;
+    uint8_t *flags = axisData->flags.internalArray;
+    Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+    Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
+    Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
+
+    // Size floating containers to their parents
+    if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER)) {
+        Clay_FloatingElementConfig *floatingElementConfig = Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER).floatingElementConfig;
+        Clay__LayoutElementHashMapSlot *parentSlot = Clay__GetHashMapSlot(floatingElementConfig->parentId);
+        if (parentSlot) {
+            Clay_LayoutElement *parentLayoutElement = parentSlot->layoutElement;
+            if (rootElement->layoutConfig->sizing.width.type == CLAY__SIZING_TYPE_GROW) {
+                rootElement->dimensions.width = parentLayoutElement->dimensions.width;
+            }
+            if (rootElement->layoutConfig->sizing.height.type == CLAY__SIZING_TYPE_GROW) {
+                rootElement->dimensions.height = parentLayoutElement->dimensions.height;
             }
         }
+    }
 
-        rootElement->dimensions.width = CLAY__MIN(CLAY__MAX(rootElement->dimensions.width, rootElement->layoutConfig->sizing.width.size.minMax.min), rootElement->layoutConfig->sizing.width.size.minMax.max);
-        rootElement->dimensions.height = CLAY__MIN(CLAY__MAX(rootElement->dimensions.height, rootElement->layoutConfig->sizing.height.size.minMax.min), rootElement->layoutConfig->sizing.height.size.minMax.max);
+    rootElement->dimensions.width = CLAY__MIN(CLAY__MAX(rootElement->dimensions.width, rootElement->layoutConfig->sizing.width.size.minMax.min), rootElement->layoutConfig->sizing.width.size.minMax.max);
+    rootElement->dimensions.height = CLAY__MIN(CLAY__MAX(rootElement->dimensions.height, rootElement->layoutConfig->sizing.height.size.minMax.min), rootElement->layoutConfig->sizing.height.size.minMax.max);
+    sizes[root->layoutElementIndex] = xAxis ? rootElement->dimensions.width : rootElement->dimensions.height;
 
-        for (uint32_t i = 0; i < bfsBuffer.length; ++i) {
-            int32_t parentIndex = Clay__int32_tArray_Get(&bfsBuffer, i);
-            Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&Clay__layoutElements, parentIndex);
-            Clay_LayoutConfig *parentStyleConfig = parent->layoutConfig;
-            int growContainerCount = 0;
-            float parentSize = xAxis ? parent->dimensions.width : parent->dimensions.height;
-            float parentPadding = (float)(xAxis ? parent->layoutConfig->padding.x : parent->layoutConfig->padding.y);
-            float innerContentSize = 0, growContainerContentSize = 0, totalPaddingAndChildGaps = parentPadding * 2;
-            bool sizingAlongAxis = (xAxis && parentStyleConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentStyleConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
-            resizableContainerBuffer.length = 0;
-            float parentChildGap = parentStyleConfig->childGap;
-
-            for (int childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
-                int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
-
-                if (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && childElement->childrenOrTextContent.children.length > 0) {
-                    Clay__int32_tArray_Add(&bfsBuffer, childElementIndex);
-                }
+    for (uint32_t i = 0; i < bfsBuffer.length; ++i) {
+        int32_t parentIndex = Clay__int32_tArray_Get(&bfsBuffer, i);
+        if (context->incrementalLayoutEnabled && Clay__RestoreCachedLayout(Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex), xAxis)) {
+            continue;
+        }
+        int32_t *parentChildren = &context->layoutElementChildren.internalArray[axisData->firstChildOffsets.internalArray[parentIndex]];
+        int32_t parentChildCount = axisData->childCounts.internalArray[parentIndex];
+        uint8_t parentFlags = flags[parentIndex];
+        int growContainerCount = 0;
+        float parentSize = sizes[parentIndex];
+        float parentPadding = axisData->paddings.internalArray[parentIndex];
+        float innerContentSize = 0, growContainerContentSize = 0, totalPaddingAndChildGaps = parentPadding * 2;
+        bool sizingAlongAxis = parentFlags & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_LAYOUT_ALONG_AXIS;
+        resizableContainerBuffer.length = 0;
+        float parentChildGap = axisData->childGaps.internalArray[parentIndex];
+
+        for (int childOffset = 0; childOffset < parentChildCount; childOffset++) {
+            int32_t childElementIndex = parentChildren[childOffset];
+            uint8_t childSizingType = sizingTypes[childElementIndex];
+            float childSize = sizes[childElementIndex];
+
+            if (flags[childElementIndex] & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_HAS_CHILDREN) {
+                Clay__int32_tArray_Add(&bfsBuffer, childElementIndex);
+            }
+
+            if (flags[childElementIndex] & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_RESIZABLE) {
+                Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
+            }
 
-                if (childSizing.type != CLAY__SIZING_TYPE_PERCENT && childSizing.type != CLAY__SIZING_TYPE_FIXED && (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || (Clay__FindElementConfigWithType(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig->wrapMode == CLAY_TEXT_WRAP_WORDS))) {
-                    Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
+            if (sizingAlongAxis) {
+                innerContentSize += (childSizingType == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
+                if (childSizingType == CLAY__SIZING_TYPE_GROW) {
+                    growContainerContentSize += childSize;
+                    growContainerCount++;
+                }
+                if (childOffset > 0) {
+                    innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
+                    totalPaddingAndChildGaps += parentChildGap;
                 }
+            } else {
+                innerContentSize = CLAY__MAX(childSize, innerContentSize);
+            }
+        }
 
+        // Expand percentage containers to size
+        for (int childOffset = 0; childOffset < parentChildCount; childOffset++) {
+            int32_t childElementIndex = parentChildren[childOffset];
+            if (sizingTypes[childElementIndex] == CLAY__SIZING_TYPE_PERCENT) {
+                float *childSize = &sizes[childElementIndex];
+                *childSize = (parentSize - totalPaddingAndChildGaps) * axisData->sizingMins.internalArray[childElementIndex];
                 if (sizingAlongAxis) {
-                    innerContentSize += (childSizing.type == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
-                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        growContainerContentSize += childSize;
-                        growContainerCount++;
-                    }
+                    innerContentSize += *childSize;
                     if (childOffset > 0) {
                         innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
                         totalPaddingAndChildGaps += parentChildGap;
                     }
                 } else {
-                    innerContentSize = CLAY__MAX(childSize, innerContentSize);
-                }
-            }
-
-            // Expand percentage containers to size
-            for (int childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
-                int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-                if (childSizing.type == CLAY__SIZING_TYPE_PERCENT) {
-                    *childSize = (parentSize - totalPaddingAndChildGaps) * childSizing.size.percent;
-                    if (sizingAlongAxis) {
-                        innerContentSize += *childSize;
-                        if (childOffset > 0) {
-                            innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
-                            totalPaddingAndChildGaps += parentChildGap;
-                        }
-                    } else {
-                        innerContentSize = CLAY__MAX(*childSize, innerContentSize);
-                    }
+                    innerContentSize = CLAY__MAX(*childSize, innerContentSize);
                 }
             }
+        }
 
-            if (sizingAlongAxis) {
-                float sizeToDistribute = parentSize - parentPadding * 2 - innerContentSize;
-                // If the content is too large, compress the children as much as possible
-                if (sizeToDistribute < 0) {
-                    // If the parent can scroll in the axis direction in this direction, don't compress children, just leave them alone
-                    if (Clay__ElementHasConfig(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                        Clay_ScrollElementConfig *scrollElementConfig = Clay__FindElementConfigWithType(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                        if (((xAxis && scrollElementConfig->horizontal) || (!xAxis && scrollElementConfig->vertical))) {
-                            continue;
-                        }
-                    }
+        if (sizingAlongAxis) {
+            float sizeToDistribute = parentSize - parentPadding * 2 - innerContentSize;
+            // If the content is too large, compress the children as much as possible
+            if (sizeToDistribute < 0) {
+                // If the parent can scroll in the axis direction in this direction, don't compress children, just leave them alone
+                if (!(parentFlags & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLLS_ALONG_AXIS)) {
                     // Scrolling containers preferentially compress before others
-                    sizeToDistribute = Clay__DistributeSizeAmongChildren(xAxis, sizeToDistribute, resizableContainerBuffer, CLAY__SIZE_DISTRIBUTION_TYPE_SCROLL_CONTAINER);
+                    sizeToDistribute = Clay__DistributeSizeAmongChildren(xAxis, sizeToDistribute, resizableContainerBuffer, CLAY__SIZE_DISTRIBUTION_TYPE_SCROLL_CONTAINER, &scratch);
 
                     // If there is still height to make up, remove it from all containers that haven't hit their minimum size
                     if (sizeToDistribute < 0) {
-                        Clay__DistributeSizeAmongChildren(xAxis, sizeToDistribute, resizableContainerBuffer, CLAY__SIZE_DISTRIBUTION_TYPE_RESIZEABLE_CONTAINER);
-                    }
-                // The content is too small, allow SIZING_GROW containers to expand
-                } else if (sizeToDistribute > 0 && growContainerCount > 0) {
-                    float targetSize = (sizeToDistribute + growContainerContentSize) / growContainerCount;
-                    for (uint32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
-                        Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&resizableContainerBuffer, childOffset));
-                        Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                        if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                            float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-                            float *minSize = xAxis ? &childElement->minDimensions.width : &childElement->minDimensions.height;
-                            if (targetSize < *minSize) {
-                                growContainerContentSize -= *minSize;
-                                Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childOffset);
-                                growContainerCount--;
-                                targetSize = (sizeToDistribute + growContainerContentSize) / growContainerCount;
-                                childOffset = -1;
-                                continue;
-                            }
-                            *childSize = targetSize;
-                        }
+                        Clay__DistributeSizeAmongChildren(xAxis, sizeToDistribute, resizableContainerBuffer, CLAY__SIZE_DISTRIBUTION_TYPE_RESIZEABLE_CONTAINER, &scratch);
                     }
                 }
-            // Sizing along the non layout axis ("off axis")
-            } else {
+            // The content is too small, allow SIZING_GROW containers to expand
+            } else if (sizeToDistribute > 0 && growContainerCount > 0) {
+                // Grow containers with a min size above the shared target keep their size and drop out of the share, which lowers
+                // the target. Dropping them largest min size first means each one only needs to be checked once.
+                Clay__floatArray growMinSizes = scratch.breakpoints;
+                growMinSizes.length = 0;
                 for (uint32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
-                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&resizableContainerBuffer, childOffset));
-                    Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                    float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-
-                    if (!xAxis && Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE)) {
-                        continue; // Currently we don't support resizing aspect ratio images on the Y axis because it would break the ratio
+                    int32_t childElementIndex = Clay__int32_tArray_Get(&resizableContainerBuffer, childOffset);
+                    if (sizingTypes[childElementIndex] == CLAY__SIZING_TYPE_GROW) {
+                        Clay__floatArray_Add(&growMinSizes, axisData->minSizes.internalArray[childElementIndex]);
                     }
-
-                    // If we're laying out the children of a scroll panel, grow containers expand to the height of the inner content, not the outer container
-                    float maxSize = parentSize - parentPadding * 2;
-                    if (Clay__ElementHasConfig(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
-                        Clay_ScrollElementConfig *scrollElementConfig = Clay__FindElementConfigWithType(parent, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                        if (((xAxis && scrollElementConfig->horizontal) || (!xAxis && scrollElementConfig->vertical))) {
-                            maxSize = CLAY__MAX(maxSize, innerContentSize);
-                        }
+                }
+                Clay__SortFloats(growMinSizes.internalArray, (int32_t)growMinSizes.length);
+                float targetSize = (sizeToDistribute + growContainerContentSize) / growContainerCount;
+                for (int32_t i = (int32_t)growMinSizes.length - 1; i >= 0 && targetSize < growMinSizes.internalArray[i]; --i) {
+                    growContainerContentSize -= growMinSizes.internalArray[i];
+                    growContainerCount--;
+                    if (growContainerCount == 0) {
+                        break;
                     }
-                    if (childSizing.type == CLAY__SIZING_TYPE_FIT) {
-                        *childSize = CLAY__MAX(childSizing.size.minMax.min, CLAY__MIN(*childSize, maxSize));
-                    } else if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        *childSize = CLAY__MIN(maxSize, childSizing.size.minMax.max);
+                    targetSize = (sizeToDistribute + growContainerContentSize) / growContainerCount;
+                }
+                for (uint32_t childOffset = 0; growContainerCount > 0 && childOffset < resizableContainerBuffer.length; childOffset++) {
+                    int32_t childElementIndex = Clay__int32_tArray_Get(&resizableContainerBuffer, childOffset);
+                    if (sizingTypes[childElementIndex] == CLAY__SIZING_TYPE_GROW && axisData->minSizes.internalArray[childElementIndex] <= targetSize) {
+                        sizes[childElementIndex] = targetSize;
                     }
                 }
             }
+        // Sizing along the non layout axis ("off axis")
+        } else {
+            // If we're laying out the children of a scroll panel, grow containers expand to the height of the inner content, not the outer container
+            float maxSize = parentSize - parentPadding * 2;
+            if (parentFlags & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_SCROLLS_ALONG_AXIS) {
+                maxSize = CLAY__MAX(maxSize, innerContentSize);
+            }
+            for (uint32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
+                int32_t childElementIndex = Clay__int32_tArray_Get(&resizableContainerBuffer, childOffset);
+                if (!xAxis && (flags[childElementIndex] & CLAY__LAYOUT_ELEMENT_AXIS_FLAG_IMAGE)) {
+                    continue; // Currently we don't support resizing aspect ratio images on the Y axis because it would break the ratio
+                }
+                if (sizingTypes[childElementIndex] == CLAY__SIZING_TYPE_FIT) {
+                    sizes[childElementIndex] = CLAY__MAX(axisData->sizingMins.internalArray[childElementIndex], CLAY__MIN(sizes[childElementIndex], maxSize));
+                } else if (sizingTypes[childElementIndex] == CLAY__SIZING_TYPE_GROW) {
+                    sizes[childElementIndex] = CLAY__MIN(maxSize, axisData->sizingMaxes.internalArray[childElementIndex]);
+                }
+            }
+        }
+
+        // The children's sizes are final for this axis, so copy them back to the layout elements
+        for (int childOffset = 0; childOffset < parentChildCount; childOffset++) {
+            int32_t childElementIndex = parentChildren[childOffset];
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+            *(xAxis ? &childElement->dimensions.width : &childElement->dimensions.height) = sizes[childElementIndex];
+        }
+    }
+}
+
+CLAY__TYPEDEF(Clay__SizingJobData, struct {
+    Clay_Context *context;
+    bool xAxis;
+    uint32_t firstRootIndex;
+});
+
+void Clay__SizeLayoutElementTreeRootJob(uint32_t jobIndex, void *jobData) {
+    Clay__SizingJobData *sizingJobData = (Clay__SizingJobData *)jobData;
+    // Jobs may run on other threads, which have their own current context. The worker's context is put back afterwards, as
+    // the thread might be in the middle of using it.
+    Clay_Context* previousContext = Clay_GetCurrentContext();
+    Clay_SetCurrentContext(sizingJobData->context);
+    Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&sizingJobData->context->layoutElementTreeRoots, sizingJobData->firstRootIndex + jobIndex);
+    Clay__SizeLayoutElementTreeRoot(sizingJobData->xAxis, sizingJobData->firstRootIndex + jobIndex, Clay__SizingScratchSlice(root->scratchOffset, root->elementCount));
+    Clay_SetCurrentContext(previousContext);
+}
+
+// Floating roots that grow to the size of their parent read an element from another tree, so they can't be sized at the same time as any other root
+bool Clay__LayoutElementTreeRootReadsParentSize(uint32_t rootIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+    Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
+    return Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER) && (rootElement->layoutConfig->sizing.width.type == CLAY__SIZING_TYPE_GROW || rootElement->layoutConfig->sizing.height.type == CLAY__SIZING_TYPE_GROW);
+}
+
+void Clay__SizeContainersAlongAxis(bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__PrepareLayoutElementAxisData(xAxis);
+    // Restoring cached layouts appends to arrays shared by every root, so roots are only sized in parallel without incremental layout
+    if (!Clay__ParallelFor || context->incrementalLayoutEnabled || context->layoutElementTreeRoots.length < 2) {
+        for (uint32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
+            Clay__SizeLayoutElementTreeRoot(xAxis, rootIndex, Clay__SizingScratchSlice(0, context->maxElementCount));
+        }
+        return;
+    }
+
+    // Count the elements in each tree, and give each root its own slice of the scratch buffers. Floating elements aren't
+    // children of their parents, so the trees don't overlap and the slices fit in the buffers.
+    Clay__LayoutElementAxisData *axisData = &context->layoutElementAxisData;
+    Clay__int32_tArray bfsBuffer = context->layoutElementChildrenBuffer;
+    uint32_t scratchOffset = 0;
+    for (uint32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        bfsBuffer.length = 0;
+        Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
+        for (uint32_t i = 0; i < bfsBuffer.length; ++i) {
+            int32_t elementIndex = bfsBuffer.internalArray[i];
+            int32_t *children = &context->layoutElementChildren.internalArray[axisData->firstChildOffsets.internalArray[elementIndex]];
+            for (int32_t childOffset = 0; childOffset < axisData->childCounts.internalArray[elementIndex]; ++childOffset) {
+                Clay__int32_tArray_Add(&bfsBuffer, children[childOffset]);
+            }
+        }
+        root->elementCount = bfsBuffer.length;
+        root->scratchOffset = scratchOffset;
+        scratchOffset += bfsBuffer.length;
+    }
+
+    // Runs of roots that only depend on their own tree are sized together, in the same order as the sequential path
+    Clay__SizingJobData sizingJobData = { .context = context, .xAxis = xAxis, .firstRootIndex = 0 };
+    for (uint32_t rootIndex = 1; rootIndex <= context->layoutElementTreeRoots.length; ++rootIndex) {
+        if (rootIndex < context->layoutElementTreeRoots.length && !Clay__LayoutElementTreeRootReadsParentSize(rootIndex) && !Clay__LayoutElementTreeRootReadsParentSize(rootIndex - 1)) {
+            continue;
+        }
+        uint32_t jobCount = rootIndex - sizingJobData.firstRootIndex;
+        if (jobCount == 1) {
+            Clay__SizeLayoutElementTreeRootJob(0, &sizingJobData);
+        } else {
+            Clay__ParallelFor(jobCount, Clay__SizeLayoutElementTreeRootJob, &sizingJobData);
         }
+        sizingJobData.firstRootIndex = rootIndex;
     }
 }
 
 Clay_String Clay__IntToString(int integer) {
+    Clay_Context* context = Clay_GetCurrentContext();
     if (integer == 0) {
         return CLAY__INIT(Clay_String) { .length = 1, .chars = "0" };
     }
-    char *chars = (char *)(Clay__dynamicStringData.internalArray + Clay__dynamicStringData.length);
+    char *chars = (char *)(context->dynamicStringData.internalArray + context->dynamicStringData.length);
     size_t length = 0;
     int sign = integer;
 
@@ -2321,44 +4142,223 @@ Clay_String Clay__IntToString(int integer) {
         chars[j] = chars[k];
         chars[k] = temp;
     }
-    Clay__dynamicStringData.length += length;
+    context->dynamicStringData.length += length;
     return CLAY__INIT(Clay_String) { .length = length, .chars = chars };
 }
 
 void Clay__AddRenderCommand(Clay_RenderCommand renderCommand) {
-    if (Clay__renderCommands.length < Clay__renderCommands.capacity - 1) {
-        Clay_RenderCommandArray_Add(&Clay__renderCommands, renderCommand);
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->renderCommands.length < context->renderCommands.capacity - 1) {
+        Clay_RenderCommandArray_Add(&context->renderCommands, renderCommand);
     } else {
-        if (!Clay__booleanWarnings.maxRenderCommandsExceeded) {
-            Clay__booleanWarnings.maxRenderCommandsExceeded = true;
-            Clay__errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+        if (!context->booleanWarnings.maxRenderCommandsExceeded) {
+            context->booleanWarnings.maxRenderCommandsExceeded = true;
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                 .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
                 .errorText = CLAY_STRING("Clay ran out of capacity while attempting to create render commands. This is usually caused by a large amount of wrapping text elements while close to the max element capacity. Try using Clay_SetMaxElementCount() with a higher value."),
-                .userData = Clay__errorHandler.userData });
+                .userData = context->errorHandler.userData });
         }
     }
 }
 
-bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
-    if (Clay__disableCulling) {
+bool Clay__ElementIsOutsideRectangle(Clay_BoundingBox *boundingBox, Clay_BoundingBox *cullingRectangle) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->disableCulling) {
         return false;
     }
 
-    return (boundingBox->x > (float)Clay__layoutDimensions.width) ||
-           (boundingBox->y > (float)Clay__layoutDimensions.height) ||
-           (boundingBox->x + boundingBox->width < 0) ||
-           (boundingBox->y + boundingBox->height < 0);
+    return (boundingBox->x > cullingRectangle->x + cullingRectangle->width) ||
+           (boundingBox->y > cullingRectangle->y + cullingRectangle->height) ||
+           (boundingBox->x + boundingBox->width < cullingRectangle->x) ||
+           (boundingBox->y + boundingBox->height < cullingRectangle->y);
+}
+
+bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_BoundingBox screen = { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height };
+    return Clay__ElementIsOutsideRectangle(boundingBox, &screen);
+}
+
+Clay_BoundingBox Clay__IntersectBoundingBoxes(Clay_BoundingBox a, Clay_BoundingBox b) {
+    float left = CLAY__MAX(a.x, b.x);
+    float top = CLAY__MAX(a.y, b.y);
+    float right = CLAY__MIN(a.x + a.width, b.x + b.width);
+    float bottom = CLAY__MIN(a.y + a.height, b.y + b.height);
+    return CLAY__INIT(Clay_BoundingBox) { left, top, CLAY__MAX(right - left, 0), CLAY__MAX(bottom - top, 0) };
+}
+
+// Returns NULL while wrapped text caching is disabled
+Clay__WrappedLinesCacheEntry *Clay__GetWrappedLinesCacheEntry(Clay__MeasureTextCacheItem *cacheItem) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!context->wrappedTextCachingEnabled || cacheItem == &CLAY__MEASURE_TEXT_CACHE_ITEM_DEFAULT) {
+        return CLAY__NULL;
+    }
+    return &context->wrappedLinesCacheEntries.internalArray[cacheItem - context->measureTextHashMapInternal.internalArray];
+}
+
+// Returns the lines the text was wrapped into at this width earlier in this frame or in the previous frame, or NULL if
+// it needs to be wrapped again. Lines from the previous frame are copied forward so they can be reused in the next one.
+Clay__CachedTextLine *Clay__FindWrappedLines(Clay__WrappedLinesCacheEntry *cacheEntry, float width) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!cacheEntry || cacheEntry->wrappedLinesGeneration == 0 || cacheEntry->wrappedWidth != width) {
+        return CLAY__NULL;
+    }
+    if (cacheEntry->wrappedLinesGeneration == context->generation) {
+        return &context->wrappedLineCache.internalArray[cacheEntry->wrappedLinesStartIndex];
+    }
+    if (cacheEntry->wrappedLinesGeneration != context->generation - 1 || context->wrappedLineCache.length + cacheEntry->wrappedLinesCount > context->wrappedLineCache.capacity) {
+        return CLAY__NULL;
+    }
+    uint32_t startIndex = context->wrappedLineCache.length;
+    for (uint32_t i = 0; i < cacheEntry->wrappedLinesCount; ++i) {
+        Clay__CachedTextLineArray_Add(&context->wrappedLineCache, context->previousWrappedLineCache.internalArray[cacheEntry->wrappedLinesStartIndex + i]);
+    }
+    cacheEntry->wrappedLinesStartIndex = startIndex;
+    cacheEntry->wrappedLinesGeneration = context->generation;
+    return &context->wrappedLineCache.internalArray[startIndex];
+}
+
+void Clay__StoreWrappedLines(Clay__WrappedLinesCacheEntry *cacheEntry, float width, Clay__TextElementData *textElementData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!cacheEntry) {
+        return;
+    }
+    if (context->wrappedLineCache.length + textElementData->wrappedLines.length > context->wrappedLineCache.capacity) {
+        cacheEntry->wrappedLinesGeneration = 0;
+        return;
+    }
+    cacheEntry->wrappedWidth = width;
+    cacheEntry->wrappedLinesGeneration = context->generation;
+    cacheEntry->wrappedLinesStartIndex = context->wrappedLineCache.length;
+    cacheEntry->wrappedLinesCount = textElementData->wrappedLines.length;
+    for (uint32_t i = 0; i < textElementData->wrappedLines.length; ++i) {
+        Clay__WrappedTextLine *wrappedLine = &textElementData->wrappedLines.internalArray[i];
+        Clay__CachedTextLineArray_Add(&context->wrappedLineCache, CLAY__INIT(Clay__CachedTextLine) { wrappedLine->dimensions, (uint32_t)(wrappedLine->line.chars - textElementData->text.chars), (uint32_t)wrappedLine->line.length });
+    }
+}
+
+void Clay__ReverseRenderCommands(uint32_t startIndex, uint32_t endIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommand *commands = context->renderCommands.internalArray;
+    while (startIndex + 1 < endIndex) {
+        Clay_RenderCommand temp = commands[startIndex];
+        commands[startIndex++] = commands[--endIndex];
+        commands[endIndex] = temp;
+    }
+}
+
+// Stable insertion sort of the layout tree roots by zIndex, so that floating elements are rendered in zIndex order and hit
+// tested in the reverse. Roots with the same zIndex keep their declaration order. It runs after positioning, because a
+// floating element can be attached inside another root with a higher zIndex, which has to be positioned first. Each root's
+// render commands are rotated into place along with it. There is one root per floating element and they are usually
+// declared in zIndex order already, so sorting in place is cheaper than keeping a second array of roots or commands around.
+void Clay__SortLayoutElementTreeRoots(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__LayoutElementTreeRootArray *roots = &context->layoutElementTreeRoots;
+    for (uint32_t i = 1; i < roots->length; ++i) {
+        if (roots->internalArray[i].zIndex >= roots->internalArray[i - 1].zIndex) {
+            continue;
+        }
+        Clay__LayoutElementTreeRoot root = roots->internalArray[i];
+        uint32_t commandsEndIndex = i + 1 < roots->length ? roots->internalArray[i + 1].renderCommandStartIndex : context->renderCommands.length;
+        uint32_t commandCount = commandsEndIndex - root.renderCommandStartIndex;
+        uint32_t insertIndex = i;
+        while (insertIndex > 0 && roots->internalArray[insertIndex - 1].zIndex > root.zIndex) {
+            roots->internalArray[insertIndex] = roots->internalArray[insertIndex - 1];
+            roots->internalArray[insertIndex].renderCommandStartIndex += commandCount;
+            insertIndex--;
+        }
+        // Rotates the root's commands in front of those of the roots it moved past, the first of which is still in its old slot
+        uint32_t commandsStartIndex = roots->internalArray[insertIndex].renderCommandStartIndex;
+        Clay__ReverseRenderCommands(commandsStartIndex, root.renderCommandStartIndex);
+        Clay__ReverseRenderCommands(root.renderCommandStartIndex, commandsEndIndex);
+        Clay__ReverseRenderCommands(commandsStartIndex, commandsEndIndex);
+        root.renderCommandStartIndex = commandsStartIndex;
+        roots->internalArray[insertIndex] = root;
+    }
+}
+
+// Flags the elements whose children have to be positioned even when the element itself is off screen: those containing
+// the parent of a floating element, and those whose children overflow them along an axis that isn't clipped. Children
+// always have a higher index than their parent, so a single backwards pass sees every child before its parent.
+void Clay__MarkSubtreesRequiringLayout(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->disableCulling) {
+        return;
+    }
+    for (uint32_t i = 0; i < context->layoutElementTreeRoots.length; ++i) {
+        Clay__LayoutElementHashMapSlot *parentSlot = Clay__GetHashMapSlot(context->layoutElementTreeRoots.internalArray[i].parentId);
+        // Parents that weren't declared this frame point at a stale element
+        if (parentSlot->itemIndex != -1 && Clay__GetHashMapSlotItem(parentSlot)->generation == context->generation + 1) {
+            parentSlot->layoutElement->subtreeRequiresLayout = true;
+        }
+    }
+    for (int32_t i = (int32_t)context->layoutElements.length - 1; i >= 0; --i) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[i];
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || layoutElement->childrenOrTextContent.children.length == 0) {
+            continue;
+        }
+        Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+        Clay_Dimensions contentSize = { (float)layoutConfig->padding.x * 2, (float)layoutConfig->padding.y * 2 };
+        float childrenAlongAxis = (float)((layoutElement->childrenOrTextContent.children.length - 1) * layoutConfig->childGap);
+        float childrenAcrossAxis = 0;
+        bool subtreeRequiresLayout = layoutElement->subtreeRequiresLayout;
+        for (int j = 0; j < layoutElement->childrenOrTextContent.children.length; ++j) {
+            Clay_LayoutElement *childElement = &context->layoutElements.internalArray[layoutElement->childrenOrTextContent.children.elements[j]];
+            subtreeRequiresLayout = subtreeRequiresLayout || childElement->subtreeRequiresLayout;
+            if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+                childrenAlongAxis += childElement->dimensions.width;
+                childrenAcrossAxis = CLAY__MAX(childrenAcrossAxis, childElement->dimensions.height);
+            } else {
+                childrenAlongAxis += childElement->dimensions.height;
+                childrenAcrossAxis = CLAY__MAX(childrenAcrossAxis, childElement->dimensions.width);
+            }
+        }
+        if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
+            contentSize.width += childrenAlongAxis;
+            contentSize.height += childrenAcrossAxis;
+        } else {
+            contentSize.width += childrenAcrossAxis;
+            contentSize.height += childrenAlongAxis;
+        }
+        bool clipX = false, clipY = false;
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+            Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+            clipX = scrollConfig->horizontal;
+            clipY = scrollConfig->vertical;
+        }
+        // The tolerance absorbs rounding in the sizes distributed to grow containers
+        if ((!clipX && contentSize.width > layoutElement->dimensions.width + 0.01f) || (!clipY && contentSize.height > layoutElement->dimensions.height + 0.01f)) {
+            subtreeRequiresLayout = true;
+        }
+        layoutElement->subtreeRequiresLayout = subtreeRequiresLayout;
+    }
 }
 
 void Clay__CalculateFinalLayout(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ResolveMeasureTextBatch();
+    Clay__CachedTextLineArray previousWrappedLineCache = context->previousWrappedLineCache;
+    context->previousWrappedLineCache = context->wrappedLineCache;
+    context->wrappedLineCache = previousWrappedLineCache;
+    context->wrappedLineCache.length = 0;
+    if (context->incrementalLayoutEnabled) {
+        Clay__CachedTextLineArray previousCachedTextLines = context->previousCachedTextLines;
+        context->previousCachedTextLines = context->cachedTextLines;
+        context->cachedTextLines = previousCachedTextLines;
+        context->cachedTextLines.length = 0;
+    }
     // Calculate sizing along the X axis
     Clay__SizeContainersAlongAxis(true);
 
     // Wrap text
-    for (uint32_t textElementIndex = 0; textElementIndex < Clay__textElementData.length; ++textElementIndex) {
-        Clay__TextElementData *textElementData = Clay__TextElementDataArray_Get(&Clay__textElementData, textElementIndex);
-        textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &Clay__wrappedTextLines.internalArray[Clay__wrappedTextLines.length] };
-        Clay_LayoutElement *containerElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, (int)textElementData->elementIndex);
+    for (uint32_t textElementIndex = 0; textElementIndex < context->textElementData.length; ++textElementIndex) {
+        Clay__TextElementData *textElementData = Clay__TextElementDataArray_Get(&context->textElementData, textElementIndex);
+        Clay_LayoutElement *containerElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)textElementData->elementIndex);
+        if (Clay__LayoutCacheRestored(containerElement)) {
+            continue;
+        }
+        textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &context->wrappedTextLines.internalArray[context->wrappedTextLines.length] };
         Clay_TextElementConfig *textConfig = Clay__FindElementConfigWithType(containerElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig;
         Clay__MeasureTextCacheItem *measureTextCacheItem = Clay__MeasureTextCached(&textElementData->text, textConfig);
         float lineWidth = 0;
@@ -2366,75 +4366,108 @@ void Clay__CalculateFinalLayout(void) {
         uint32_t lineLengthChars = 0;
         uint32_t lineStartOffset = 0;
         if (textElementData->preferredDimensions.width <= containerElement->dimensions.width) {
-            Clay__WrappedTextLineArray_Add(&Clay__wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { containerElement->dimensions,  textElementData->text });
+            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { containerElement->dimensions,  textElementData->text });
             textElementData->wrappedLines.length++;
             continue;
         }
-        int32_t wordIndex = measureTextCacheItem->measuredWordsStartIndex;
-        while (wordIndex != -1) {
-            if (Clay__wrappedTextLines.length > Clay__wrappedTextLines.capacity - 1) {
+        float containerWidth = containerElement->dimensions.width;
+        Clay__WrappedLinesCacheEntry *wrappedLinesCacheEntry = Clay__GetWrappedLinesCacheEntry(measureTextCacheItem);
+        Clay__CachedTextLine *cachedLines = Clay__FindWrappedLines(wrappedLinesCacheEntry, containerWidth);
+        if (cachedLines) {
+            for (uint32_t i = 0; i < wrappedLinesCacheEntry->wrappedLinesCount && context->wrappedTextLines.length < context->wrappedTextLines.capacity; ++i) {
+                Clay__CachedTextLine *cachedLine = &cachedLines[i];
+                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { cachedLine->dimensions, { .length = cachedLine->length, .chars = &textElementData->text.chars[cachedLine->startOffset] } });
+                textElementData->wrappedLines.length++;
+            }
+            containerElement->dimensions.height = lineHeight * textElementData->wrappedLines.length;
+            continue;
+        }
+        Clay__MeasuredWord *words = &context->measuredWords.internalArray[measureTextCacheItem->measuredWordsStartIndex];
+        uint32_t wordIndex = 0;
+        bool wrappedLinesComplete = true;
+        while (wordIndex < measureTextCacheItem->measuredWordsCount) {
+            if (context->wrappedTextLines.length > context->wrappedTextLines.capacity - 1) {
+                wrappedLinesComplete = false;
                 break;
             }
-            Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&Clay__measuredWords, wordIndex);
+            Clay__MeasuredWord *measuredWord = &words[wordIndex];
             // Only word on the line is too large, just render it anyway
-            if (lineLengthChars == 0 && lineWidth + measuredWord->width > containerElement->dimensions.width) {
-                Clay__WrappedTextLineArray_Add(&Clay__wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { measuredWord->width, lineHeight }, { .length = measuredWord->length, .chars = &textElementData->text.chars[measuredWord->startOffset] } });
+            if (lineLengthChars == 0 && lineWidth + measuredWord->width > containerWidth) {
+                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { measuredWord->width, lineHeight }, { .length = measuredWord->length, .chars = &textElementData->text.chars[measuredWord->startOffset] } });
                 textElementData->wrappedLines.length++;
-                wordIndex = measuredWord->next;
+                wordIndex++;
             }
             // measuredWord->length == 0 means a newline character
-            else if (measuredWord->length == 0 || lineWidth + measuredWord->width > containerElement->dimensions.width) {
+            else if (measuredWord->length == 0 || lineWidth + measuredWord->width > containerWidth) {
                 // Wrapped text lines list has overflowed, just render out the line
-                Clay__WrappedTextLineArray_Add(&Clay__wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, { .length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
+                Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, { .length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
                 textElementData->wrappedLines.length++;
                 if (lineLengthChars == 0 || measuredWord->length == 0) {
-                    wordIndex = measuredWord->next;
+                    wordIndex++;
                 }
                 lineWidth = 0;
                 lineLengthChars = 0;
                 lineStartOffset = measuredWord->startOffset;
             } else {
-                lineWidth += measuredWord->width;
-                lineLengthChars += measuredWord->length;
-                wordIndex = measuredWord->next;
+                // The word fits, so binary search the running widths for the last word before the next newline that also fits
+                uint32_t lastWordIndex = wordIndex;
+                uint32_t high = measuredWord->lineBreakIndex - 1;
+                while (lastWordIndex < high) {
+                    uint32_t middle = (lastWordIndex + high + 1) / 2;
+                    if (lineWidth + (words[middle].widthBefore + words[middle].width - measuredWord->widthBefore) <= containerWidth) {
+                        lastWordIndex = middle;
+                    } else {
+                        high = middle - 1;
+                    }
+                }
+                Clay__MeasuredWord *lastWord = &words[lastWordIndex];
+                lineWidth += lastWord->widthBefore + lastWord->width - measuredWord->widthBefore;
+                lineLengthChars += lastWord->startOffset + lastWord->length - measuredWord->startOffset;
+                wordIndex = lastWordIndex + 1;
             }
         }
         if (lineLengthChars > 0) {
-            Clay__WrappedTextLineArray_Add(&Clay__wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, {.length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
+            Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth, lineHeight }, {.length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
             textElementData->wrappedLines.length++;
         }
+        if (wrappedLinesComplete) {
+            Clay__StoreWrappedLines(wrappedLinesCacheEntry, containerWidth, textElementData);
+        }
         containerElement->dimensions.height = lineHeight * textElementData->wrappedLines.length;
     }
 
     // Scale vertical image heights according to aspect ratio
-    for (uint32_t i = 0; i < Clay__imageElementPointers.length; ++i) {
-        Clay_LayoutElement* imageElement = Clay__LayoutElementPointerArray_Get(&Clay__imageElementPointers, i);
+    for (uint32_t i = 0; i < context->imageElementPointers.length; ++i) {
+        Clay_LayoutElement* imageElement = Clay__LayoutElementPointerArray_Get(&context->imageElementPointers, i);
+        if (Clay__LayoutCacheRestored(imageElement)) {
+            continue;
+        }
         Clay_ImageElementConfig *config = Clay__FindElementConfigWithType(imageElement, CLAY__ELEMENT_CONFIG_TYPE_IMAGE).imageElementConfig;
         imageElement->dimensions.height = (config->sourceDimensions.height / CLAY__MAX(config->sourceDimensions.width, 1)) * imageElement->dimensions.width;
     }
 
     // Propagate effect of text wrapping, image aspect scaling etc. on height of parents
-    Clay__LayoutElementTreeNodeArray dfsBuffer = Clay__layoutElementTreeNodeArray1;
+    Clay__LayoutElementTreeNodeArray dfsBuffer = context->layoutElementTreeNodeArray1;
     dfsBuffer.length = 0;
-    for (uint32_t i = 0; i < Clay__layoutElementTreeRoots.length; ++i) {
-        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&Clay__layoutElementTreeRoots, i);
-        Clay__treeNodeVisited.internalArray[dfsBuffer.length] = false;
-        Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, (int)root->layoutElementIndex) });
+    for (uint32_t i = 0; i < context->layoutElementTreeRoots.length; ++i) {
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, i);
+        context->treeNodeVisited.internalArray[dfsBuffer.length] = false;
+        Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex) });
     }
     while (dfsBuffer.length > 0) {
         Clay__LayoutElementTreeNode *currentElementTreeNode = Clay__LayoutElementTreeNodeArray_Get(&dfsBuffer, (int)dfsBuffer.length - 1);
         Clay_LayoutElement *currentElement = currentElementTreeNode->layoutElement;
-        if (!Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
-            Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
-            // If the element has no children or is the container for a text element, don't bother inspecting it
-            if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || currentElement->childrenOrTextContent.children.length == 0) {
+        if (!context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
+            context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
+            // If the element has no children, is the container for a text element or was restored from the previous frame, don't bother inspecting it
+            if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || currentElement->childrenOrTextContent.children.length == 0 || Clay__LayoutCacheRestored(currentElement)) {
                 dfsBuffer.length--;
                 continue;
             }
             // Add the children to the DFS buffer (needs to be pushed in reverse so that stack traversal is in correct layout order)
             for (int i = 0; i < currentElement->childrenOrTextContent.children.length; i++) {
-                Clay__treeNodeVisited.internalArray[dfsBuffer.length] = false;
-                Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[i]) });
+                context->treeNodeVisited.internalArray[dfsBuffer.length] = false;
+                Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]) });
             }
             continue;
         }
@@ -2448,7 +4481,7 @@ void Clay__CalculateFinalLayout(void) {
         if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
             // Resize any parent containers that have grown in height along their non layout axis
             for (int j = 0; j < currentElement->childrenOrTextContent.children.length; ++j) {
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[j]);
+                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[j]);
                 float childHeightWithPadding = CLAY__MAX(childElement->dimensions.height + layoutConfig->padding.y * 2, currentElement->dimensions.height);
                 currentElement->dimensions.height = CLAY__MIN(CLAY__MAX(childHeightWithPadding, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
             }
@@ -2456,7 +4489,7 @@ void Clay__CalculateFinalLayout(void) {
             // Resizing along the layout axis
             float contentHeight = (float)layoutConfig->padding.y * 2;
             for (int j = 0; j < currentElement->childrenOrTextContent.children.length; ++j) {
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[j]);
+                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[j]);
                 contentHeight += childElement->dimensions.height;
             }
             contentHeight += (float)(CLAY__MAX(currentElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
@@ -2464,23 +4497,46 @@ void Clay__CalculateFinalLayout(void) {
         }
     }
 
+    if (context->incrementalLayoutEnabled) {
+        for (uint32_t i = 0; i < context->layoutElements.length; ++i) {
+            Clay_LayoutElement *layoutElement = Clay_LayoutElementArray_Get(&context->layoutElements, i);
+            if (layoutElement->layoutCache) {
+                layoutElement->layoutCache->contentHeight = layoutElement->dimensions.height;
+            }
+        }
+    }
+
     // Calculate sizing along the Y axis
     Clay__SizeContainersAlongAxis(false);
 
+    if (context->incrementalLayoutEnabled) {
+        Clay__StoreLayoutCache();
+    }
+
+    Clay__MarkSubtreesRequiringLayout();
+
     // Calculate final positions and generate render commands
-    Clay__renderCommands.length = 0;
+    context->renderCommands.length = 0;
+    context->hitTestNodes.length = 0;
     dfsBuffer.length = 0;
-    for (uint32_t rootIndex = 0; rootIndex < Clay__layoutElementTreeRoots.length; ++rootIndex) {
+    // Indexes of the hit test nodes for the elements on the path from the root to the current element
+    Clay__int32_tArray hitTestNodeStack = context->reusableElementIndexBuffer;
+    Clay_BoundingBoxArray *cullingRectangles = &context->cullingRectangles;
+    for (uint32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
         dfsBuffer.length = 0;
-        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&Clay__layoutElementTreeRoots, rootIndex);
-        Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, (int)root->layoutElementIndex);
+        hitTestNodeStack.length = 0;
+        cullingRectangles->length = 0;
+        Clay_BoundingBoxArray_Add(cullingRectangles, CLAY__INIT(Clay_BoundingBox) { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height });
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
+        root->renderCommandStartIndex = context->renderCommands.length;
         Clay_Vector2 rootPosition = {0};
-        Clay_LayoutElementHashMapItem *parentHashMapItem = Clay__GetHashMapItem(root->parentId);
+        Clay__LayoutElementHashMapSlot *parentHashMapSlot = Clay__GetHashMapSlot(root->parentId);
         // Position root floating containers
-        if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER) && parentHashMapItem) {
+        if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER) && parentHashMapSlot) {
             Clay_FloatingElementConfig *config = Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER).floatingElementConfig;
             Clay_Dimensions rootDimensions = rootElement->dimensions;
-            Clay_BoundingBox parentBoundingBox = parentHashMapItem->boundingBox;
+            Clay_BoundingBox parentBoundingBox = parentHashMapSlot->boundingBox;
             // Set X position
             Clay_Vector2 targetAttachPosition = {0};
             switch (config->attachment.parent) {
@@ -2532,45 +4588,47 @@ void Clay__CalculateFinalLayout(void) {
             rootPosition = targetAttachPosition;
         }
         if (root->clipElementId) {
-            Clay_LayoutElementHashMapItem *clipHashMapItem = Clay__GetHashMapItem(root->clipElementId);
-            if (clipHashMapItem) {
+            Clay__LayoutElementHashMapSlot *clipHashMapSlot = Clay__GetHashMapSlot(root->clipElementId);
+            if (clipHashMapSlot) {
                 // Floating elements that are attached to scrolling contents won't be correctly positioned if external scroll handling is enabled, fix here
-                if (Clay__externalScrollHandlingEnabled) {
-                    Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(clipHashMapItem->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                    for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
-                        if (mapping->layoutElement == clipHashMapItem->layoutElement) {
-                            root->pointerOffset = mapping->scrollPosition;
-                            if (scrollConfig->horizontal) {
-                                rootPosition.x += mapping->scrollPosition.x;
-                            }
-                            if (scrollConfig->vertical) {
-                                rootPosition.y += mapping->scrollPosition.y;
-                            }
-                            break;
+                if (context->externalScrollHandlingEnabled) {
+                    Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(clipHashMapSlot->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
+                    Clay__ScrollContainerDataInternal *mapping = Clay__GetScrollContainerData(root->clipElementId);
+                    if (mapping && mapping->layoutElement == clipHashMapSlot->layoutElement) {
+                        root->pointerOffset = mapping->scrollPosition;
+                        if (scrollConfig->horizontal) {
+                            rootPosition.x += mapping->scrollPosition.x;
+                        }
+                        if (scrollConfig->vertical) {
+                            rootPosition.y += mapping->scrollPosition.y;
                         }
                     }
                 }
                 Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
-                    .boundingBox = clipHashMapItem->boundingBox,
+                    .boundingBox = clipHashMapSlot->boundingBox,
                     .config = { .scrollElementConfig = Clay__StoreScrollElementConfig(CLAY__INIT(Clay_ScrollElementConfig){0}) },
                     .id = Clay__RehashWithNumber(rootElement->id, 10), // TODO need a better strategy for managing derived ids
                     .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_START,
                 });
+                cullingRectangles->internalArray[0] = Clay__IntersectBoundingBoxes(cullingRectangles->internalArray[0], clipHashMapSlot->boundingBox);
             }
         }
         Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = rootElement, .position = rootPosition, .nextChildOffset = { .x = (float)rootElement->layoutConfig->padding.x, .y = (float)rootElement->layoutConfig->padding.y } });
+        root->hitTestNodeIndex = context->hitTestNodes.length;
 
-        Clay__treeNodeVisited.internalArray[0] = false;
+        context->treeNodeVisited.internalArray[0] = false;
         while (dfsBuffer.length > 0) {
             Clay__LayoutElementTreeNode *currentElementTreeNode = Clay__LayoutElementTreeNodeArray_Get(&dfsBuffer, (int)dfsBuffer.length - 1);
             Clay_LayoutElement *currentElement = currentElementTreeNode->layoutElement;
             Clay_LayoutConfig *layoutConfig = currentElement->layoutConfig;
             Clay_Vector2 scrollOffset = {0};
+            Clay_BoundingBox *cullingRectangle = &cullingRectangles->internalArray[cullingRectangles->length - 1];
+
+            bool skipChildren = false;
 
             // This will only be run a single time for each element in downwards DFS order
-            if (!Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
-                Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
+            if (!context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
+                context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
 
                 Clay_BoundingBox currentElementBoundingBox = { currentElementTreeNode->position.x, currentElementTreeNode->position.y, currentElement->dimensions.width, currentElement->dimensions.height };
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER)) {
@@ -2586,32 +4644,37 @@ void Clay__CalculateFinalLayout(void) {
                 // Apply scroll offsets to container
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
                     Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-
-                    // This linear scan could theoretically be slow under very strange conditions, but I can't imagine a real UI with more than a few 10's of scroll containers
-                    for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
-                        if (mapping->layoutElement == currentElement) {
-                            scrollContainerData = mapping;
-                            mapping->boundingBox = currentElementBoundingBox;
-                            if (scrollConfig->horizontal) {
-                                scrollOffset.x = mapping->scrollPosition.x;
-                            }
-                            if (scrollConfig->vertical) {
-                                scrollOffset.y = mapping->scrollPosition.y;
-                            }
-                            if (Clay__externalScrollHandlingEnabled) {
-                                scrollOffset = CLAY__INIT(Clay_Vector2) {0};
-                            }
-                            break;
+                    Clay__ScrollContainerDataInternal *mapping = Clay__GetScrollContainerData(currentElement->id);
+                    if (mapping && mapping->layoutElement == currentElement) {
+                        scrollContainerData = mapping;
+                        mapping->boundingBox = currentElementBoundingBox;
+                        if (scrollConfig->horizontal) {
+                            scrollOffset.x = mapping->scrollPosition.x;
+                        }
+                        if (scrollConfig->vertical) {
+                            scrollOffset.y = mapping->scrollPosition.y;
+                        }
+                        if (context->externalScrollHandlingEnabled) {
+                            scrollOffset = CLAY__INIT(Clay_Vector2) {0};
                         }
                     }
                 }
 
-                Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(currentElement->id);
-                if (hashMapItem) {
-                    hashMapItem->boundingBox = currentElementBoundingBox;
+                Clay__LayoutElementHashMapSlot *hashMapSlot = Clay__GetHashMapSlot(currentElement->id);
+                if (hashMapSlot) {
+                    hashMapSlot->boundingBox = currentElementBoundingBox;
                 }
 
+                Clay_BoundingBox hitTestBoundingBox = currentElementBoundingBox;
+                hitTestBoundingBox.x -= root->pointerOffset.x;
+                hitTestBoundingBox.y -= root->pointerOffset.y;
+                Clay__HitTestNodeArray_Add(&context->hitTestNodes, CLAY__INIT(Clay__HitTestNode) {
+                    .subtreeMin = { hitTestBoundingBox.x, hitTestBoundingBox.y },
+                    .subtreeMax = { hitTestBoundingBox.x + hitTestBoundingBox.width, hitTestBoundingBox.y + hitTestBoundingBox.height },
+                    .hashMapSlotIndex = hashMapSlot == &CLAY__LAYOUT_ELEMENT_HASH_MAP_SLOT_DEFAULT ? UINT32_MAX : (uint32_t)(hashMapSlot - context->layoutElementsHashMap.internalArray),
+                });
+                Clay__int32_tArray_Add(&hitTestNodeStack, (int32_t)context->hitTestNodes.length - 1);
+
                 int sortedConfigIndexes[20];
                 for (uint32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
                     sortedConfigIndexes[elementConfigIndex] = elementConfigIndex;
@@ -2632,6 +4695,7 @@ void Clay__CalculateFinalLayout(void) {
                 }
 
                 // Create the render commands for this element
+                bool offscreen = Clay__ElementIsOutsideRectangle(&currentElementBoundingBox, cullingRectangle);
                 for (uint32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
                     Clay_ElementConfig *elementConfig = Clay__ElementConfigArraySlice_Get(&currentElement->elementConfigs, sortedConfigIndexes[elementConfigIndex]);
                     Clay_RenderCommand renderCommand = {
@@ -2640,8 +4704,7 @@ void Clay__CalculateFinalLayout(void) {
                         .id = currentElement->id,
                     };
 
-                    bool offscreen = Clay__ElementIsOffscreen(&currentElementBoundingBox);
-                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen - this won't stop their children from being rendered if they overflow
+                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen or the enclosing scroll container - this won't stop their children from being rendered if they overflow
                     bool shouldRender = !offscreen;
                     switch (elementConfig->type) {
                         case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE: {
@@ -2679,7 +4742,7 @@ void Clay__CalculateFinalLayout(void) {
                             float yPosition = lineHeightOffset;
                             for (uint32_t lineIndex = 0; lineIndex < currentElement->childrenOrTextContent.textElementData->wrappedLines.length; ++lineIndex) {
                                 Clay__WrappedTextLine wrappedLine = currentElement->childrenOrTextContent.textElementData->wrappedLines.internalArray[lineIndex]; // todo range check
-                                if (wrappedLine.line.length == 0) {
+                                if (wrappedLine.line.length == 0 || (!context->disableCulling && currentElementBoundingBox.y + yPosition + finalLineHeight < cullingRectangle->y)) {
                                     yPosition += finalLineHeight;
                                     continue;
                                 }
@@ -2692,7 +4755,7 @@ void Clay__CalculateFinalLayout(void) {
                                 });
                                 yPosition += finalLineHeight;
 
-                                if (!Clay__disableCulling && (currentElementBoundingBox.y + yPosition > Clay__layoutDimensions.height)) {
+                                if (!context->disableCulling && (currentElementBoundingBox.y + yPosition > cullingRectangle->y + cullingRectangle->height)) {
                                     break;
                                 }
                             }
@@ -2707,11 +4770,14 @@ void Clay__CalculateFinalLayout(void) {
                     if (shouldRender) {
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (offscreen) {
-                        // NOTE: You may be tempted to try an early return / continue if an element is off screen. Why bother calculating layout for its children, right?
-                        // Unfortunately, a FLOATING_CONTAINER may be defined that attaches to a child or grandchild of this element, which is large enough to still
-                        // be on screen, even if this element isn't. That depends on this element and it's children being laid out correctly (even if they are entirely off screen)
-                    }
+                }
+                // A FLOATING_CONTAINER may attach to a child or grandchild of this element and still be on screen even if this element isn't, which
+                // depends on the descendants being laid out correctly. Clay__MarkSubtreesRequiringLayout flags those subtrees, along with any whose
+                // children overflow their parent, so every other off screen subtree can skip positioning and render commands entirely.
+                skipChildren = offscreen && !currentElement->subtreeRequiresLayout;
+                // Descendants of a scroll container are only visible inside its bounds
+                if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
+                    Clay_BoundingBoxArray_Add(cullingRectangles, Clay__IntersectBoundingBoxes(*cullingRectangle, currentElementBoundingBox));
                 }
 
                 // Setup initial on-axis alignment
@@ -2719,7 +4785,7 @@ void Clay__CalculateFinalLayout(void) {
                     Clay_Dimensions contentSize = {0,0};
                     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
                         for (int i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+                            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
                             contentSize.width += childElement->dimensions.width;
                             contentSize.height = CLAY__MAX(contentSize.height, childElement->dimensions.height);
                         }
@@ -2733,7 +4799,7 @@ void Clay__CalculateFinalLayout(void) {
                         currentElementTreeNode->nextChildOffset.x += extraSpace;
                     } else {
                         for (int i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+                            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
                             contentSize.width = CLAY__MAX(contentSize.width, childElement->dimensions.width);
                             contentSize.height += childElement->dimensions.height;
                         }
@@ -2754,29 +4820,35 @@ void Clay__CalculateFinalLayout(void) {
             }
             else {
                 // DFS is returning upwards backwards
+                // All descendants have been added to the hit test hierarchy, so this node's subtree bounds are complete and can be added to its parent's
+                Clay__HitTestNode *hitTestNode = &context->hitTestNodes.internalArray[Clay__int32_tArray_RemoveSwapback(&hitTestNodeStack, (int)hitTestNodeStack.length - 1)];
+                hitTestNode->subtreeEndIndex = context->hitTestNodes.length;
+                if (hitTestNodeStack.length > 0) {
+                    Clay__HitTestNode *parentHitTestNode = &context->hitTestNodes.internalArray[Clay__int32_tArray_Get(&hitTestNodeStack, (int)hitTestNodeStack.length - 1)];
+                    parentHitTestNode->subtreeMin.x = CLAY__MIN(parentHitTestNode->subtreeMin.x, hitTestNode->subtreeMin.x);
+                    parentHitTestNode->subtreeMin.y = CLAY__MIN(parentHitTestNode->subtreeMin.y, hitTestNode->subtreeMin.y);
+                    parentHitTestNode->subtreeMax.x = CLAY__MAX(parentHitTestNode->subtreeMax.x, hitTestNode->subtreeMax.x);
+                    parentHitTestNode->subtreeMax.y = CLAY__MAX(parentHitTestNode->subtreeMax.y, hitTestNode->subtreeMax.y);
+                }
                 bool closeScrollElement = false;
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER)) {
                     closeScrollElement = true;
                     Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
-                    for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; i++) {
-                        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
-                        if (mapping->layoutElement == currentElement) {
-                            if (scrollConfig->horizontal) { scrollOffset.x = mapping->scrollPosition.x; }
-                            if (scrollConfig->vertical) { scrollOffset.y = mapping->scrollPosition.y; }
-                            if (Clay__externalScrollHandlingEnabled) {
-                                scrollOffset = CLAY__INIT(Clay_Vector2) {0};
-                            }
-                            break;
+                    Clay__ScrollContainerDataInternal *mapping = Clay__GetScrollContainerData(currentElement->id);
+                    if (mapping && mapping->layoutElement == currentElement) {
+                        if (scrollConfig->horizontal) { scrollOffset.x = mapping->scrollPosition.x; }
+                        if (scrollConfig->vertical) { scrollOffset.y = mapping->scrollPosition.y; }
+                        if (context->externalScrollHandlingEnabled) {
+                            scrollOffset = CLAY__INIT(Clay_Vector2) {0};
                         }
                     }
                 }
 
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER)) {
-                    Clay_LayoutElementHashMapItem *currentElementData = Clay__GetHashMapItem(currentElement->id);
-                    Clay_BoundingBox currentElementBoundingBox = currentElementData->boundingBox;
+                    Clay_BoundingBox currentElementBoundingBox = Clay__GetHashMapSlot(currentElement->id)->boundingBox;
 
-                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen - this won't stop their children from being rendered if they overflow
-                    if (!Clay__ElementIsOffscreen(&currentElementBoundingBox)) {
+                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen or the enclosing scroll container - this won't stop their children from being rendered if they overflow
+                    if (!Clay__ElementIsOutsideRectangle(&currentElementBoundingBox, cullingRectangle)) {
                         Clay_BorderElementConfig *borderConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER).borderElementConfig;
                         Clay_RenderCommand renderCommand = {
                                 .boundingBox = currentElementBoundingBox,
@@ -2790,7 +4862,7 @@ void Clay__CalculateFinalLayout(void) {
                             Clay_Vector2 borderOffset = { (float)layoutConfig->padding.x, (float)layoutConfig->padding.y };
                             if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
                                 for (int i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+                                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
                                     if (i > 0) {
                                         Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
                                             .boundingBox = { currentElementBoundingBox.x + borderOffset.x + scrollOffset.x, currentElementBoundingBox.y + scrollOffset.y, (float)borderConfig->betweenChildren.width, currentElement->dimensions.height },
@@ -2803,7 +4875,7 @@ void Clay__CalculateFinalLayout(void) {
                                 }
                             } else {
                                 for (int i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+                                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
                                     if (i > 0) {
                                         Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
                                                 .boundingBox = { currentElementBoundingBox.x + scrollOffset.x, currentElementBoundingBox.y + borderOffset.y + scrollOffset.y, currentElement->dimensions.width, (float)borderConfig->betweenChildren.width },
@@ -2824,6 +4896,7 @@ void Clay__CalculateFinalLayout(void) {
                         .id = Clay__RehashWithNumber(currentElement->id, 11),
                        .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_END,
                     });
+                    cullingRectangles->length = CLAY__MAX(cullingRectangles->length - 1, 1);
                 }
 
                 dfsBuffer.length--;
@@ -2831,10 +4904,10 @@ void Clay__CalculateFinalLayout(void) {
             }
 
             // Add children to the DFS buffer
-            if (!Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            if (!Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && !skipChildren) {
                 dfsBuffer.length += currentElement->childrenOrTextContent.children.length;
                 for (int i = 0; i < currentElement->childrenOrTextContent.children.length; ++i) {
-                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
+                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, currentElement->childrenOrTextContent.children.elements[i]);
                     // Alignment along non layout axis
                     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
                         currentElementTreeNode->nextChildOffset.y = currentElement->layoutConfig->padding.y;
@@ -2866,7 +4939,7 @@ void Clay__CalculateFinalLayout(void) {
                         .position = { childPosition.x, childPosition.y },
                         .nextChildOffset = { .x = (float)childElement->layoutConfig->padding.x, .y = (float)childElement->layoutConfig->padding.y },
                     };
-                    Clay__treeNodeVisited.internalArray[newNodeIndex] = false;
+                    context->treeNodeVisited.internalArray[newNodeIndex] = false;
 
                     // Update parent offsets
                     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
@@ -2882,40 +4955,296 @@ void Clay__CalculateFinalLayout(void) {
             Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) { .id = Clay__RehashWithNumber(rootElement->id, 11), .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_END });
         }
     }
+
+    Clay__SortLayoutElementTreeRoots();
 }
 
 void Clay__AttachId(Clay_ElementId elementId) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
     openLayoutElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, openLayoutElement);
-    Clay__StringArray_Add(&Clay__layoutElementIdStrings, elementId.stringId);
+    Clay__StringArray_Add(&context->layoutElementIdStrings, elementId.stringId);
 }
 
 void Clay__AttachLayoutConfig(Clay_LayoutConfig *config) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return;
     }
     Clay__GetOpenLayoutElement()->layoutConfig = config;
 }
 void Clay__AttachElementConfig(Clay_ElementConfigUnion config, Clay__ElementConfigType type) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
     openLayoutElement->elementConfigs.length++;
-    Clay__ElementConfigArray_Add(&Clay__elementConfigBuffer, CLAY__INIT(Clay_ElementConfig) { .type = type, .config = config });
+    Clay__ElementConfigArray_Add(&context->elementConfigBuffer, CLAY__INIT(Clay_ElementConfig) { .type = type, .config = config });
+}
+// The array a config type is stored in, along with what to return when it can't be stored
+CLAY__TYPEDEF(Clay__ElementConfigStorage, struct {
+    uint8_t *internalArray;
+    uint32_t *length;
+    uint32_t capacity;
+    uint32_t itemSize;
+    void *defaultConfig;
+    Clay_String capacityErrorText;
+});
+
+// Layout configs aren't an element config type, so CLAY__ELEMENT_CONFIG_TYPE_NONE stands in for them
+Clay__ElementConfigStorage Clay__GetElementConfigStorage(Clay__ElementConfigType type) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    switch (type) {
+        case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->rectangleElementConfigs.internalArray, &context->rectangleElementConfigs.length, context->rectangleElementConfigs.capacity, sizeof(Clay_RectangleElementConfig), &CLAY__RECTANGLE_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to store a rectangle config. Try using Clay_SetMaxElementCount() with a higher value.") };
+        case CLAY__ELEMENT_CONFIG_TYPE_TEXT: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->textElementConfigs.internalArray, &context->textElementConfigs.length, context->textElementConfigs.capacity, sizeof(Clay_TextElementConfig), &CLAY__TEXT_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to create a text element. Try using Clay_SetMaxTextElementCount() with a higher value.") };
+        case CLAY__ELEMENT_CONFIG_TYPE_IMAGE: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->imageElementConfigs.internalArray, &context->imageElementConfigs.length, context->imageElementConfigs.capacity, sizeof(Clay_ImageElementConfig), &CLAY__IMAGE_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to create an image element. Try using Clay_SetMaxImageElementCount() with a higher value.") };
+        case CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->floatingElementConfigs.internalArray, &context->floatingElementConfigs.length, context->floatingElementConfigs.capacity, sizeof(Clay_FloatingElementConfig), &CLAY__FLOATING_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to create a floating element. Try using Clay_SetMaxFloatingElementCount() with a higher value.") };
+        case CLAY__ELEMENT_CONFIG_TYPE_CUSTOM: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->customElementConfigs.internalArray, &context->customElementConfigs.length, context->customElementConfigs.capacity, sizeof(Clay_CustomElementConfig), &CLAY__CUSTOM_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to create a custom element. Try using Clay_SetMaxCustomElementCount() with a higher value.") };
+        case CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->scrollElementConfigs.internalArray, &context->scrollElementConfigs.length, context->scrollElementConfigs.capacity, sizeof(Clay_ScrollElementConfig), &CLAY__SCROLL_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to create a scroll container. Try using Clay_SetMaxScrollContainerCount() with a higher value.") };
+        case CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->borderElementConfigs.internalArray, &context->borderElementConfigs.length, context->borderElementConfigs.capacity, sizeof(Clay_BorderElementConfig), &CLAY__BORDER_ELEMENT_CONFIG_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to create a border element. Try using Clay_SetMaxBorderElementCount() with a higher value.") };
+        default: return CLAY__INIT(Clay__ElementConfigStorage) { (uint8_t *)context->layoutConfigs.internalArray, &context->layoutConfigs.length, context->layoutConfigs.capacity, sizeof(Clay_LayoutConfig), &CLAY_LAYOUT_DEFAULT, CLAY_STRING("Clay ran out of capacity while attempting to store a layout config. Try using Clay_SetMaxElementCount() with a higher value.") };
+    }
+}
+
+uint32_t Clay__HashConfigBytes(const void *config, uint32_t size, Clay__ElementConfigType type) {
+    const uint8_t *bytes = (const uint8_t *)config;
+    uint32_t hash = Clay__HashLayoutValue(0, type);
+    for (uint32_t i = 0; i + 4 <= size; i += 4) {
+        hash = Clay__HashLayoutValue(hash, (uint32_t)bytes[i] | ((uint32_t)bytes[i + 1] << 8) | ((uint32_t)bytes[i + 2] << 16) | ((uint32_t)bytes[i + 3] << 24));
+    }
+    for (uint32_t i = size & ~3u; i < size; ++i) {
+        hash = Clay__HashLayoutValue(hash, bytes[i]);
+    }
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash;
+}
+
+bool Clay__ConfigBytesEqual(const void *a, const void *b, uint32_t size) {
+    const uint8_t *bytesA = (const uint8_t *)a;
+    const uint8_t *bytesB = (const uint8_t *)b;
+    for (uint32_t i = 0; i < size; ++i) {
+        if (bytesA[i] != bytesB[i]) return false;
+    }
+    return true;
+}
+
+void Clay__CopyConfigBytes(void *destination, const void *source, uint32_t size) {
+    uint8_t *bytesDestination = (uint8_t *)destination;
+    const uint8_t *bytesSource = (const uint8_t *)source;
+    for (uint32_t i = 0; i < size; ++i) {
+        bytesDestination[i] = bytesSource[i];
+    }
+}
+
+#define CLAY__COPY_CONFIG_EXTENSION(destination, config, type, lastMember) Clay__CopyConfigBytes((uint8_t *)(destination) + offsetof(type, lastMember) + sizeof((config)->lastMember), (const uint8_t *)(config) + offsetof(type, lastMember) + sizeof((config)->lastMember), sizeof(type) - offsetof(type, lastMember) - sizeof((config)->lastMember))
+
+// Copies a config member by member into a zeroed value, so that configs with the same members always have the same bytes
+// regardless of what their padding held. Layout sizing treats a max of 0 as unbounded and writes CLAY__MAXFLOAT back into
+// the config during layout, so the same rewrite is applied here to make configs that will end up identical match.
+void Clay__CanonicalizeElementConfig(Clay__ElementConfigValue *canonical, const void *config, Clay__ElementConfigType type) {
+    uint8_t *bytes = (uint8_t *)canonical;
+    for (uint32_t i = 0; i < sizeof(Clay__ElementConfigValue); ++i) {
+        bytes[i] = 0;
+    }
+    switch (type) {
+        case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE: {
+            const Clay_RectangleElementConfig *source = (const Clay_RectangleElementConfig *)config;
+            Clay_RectangleElementConfig *destination = &canonical->rectangleElementConfig;
+            destination->color = source->color;
+            destination->cornerRadius = source->cornerRadius;
+            #ifdef CLAY_EXTEND_CONFIG_RECTANGLE
+            CLAY__COPY_CONFIG_EXTENSION(destination, source, Clay_RectangleElementConfig, cornerRadius);
+            #endif
+            break;
+        }
+        case CLAY__ELEMENT_CONFIG_TYPE_TEXT: {
+            const Clay_TextElementConfig *source = (const Clay_TextElementConfig *)config;
+            Clay_TextElementConfig *destination = &canonical->textElementConfig;
+            destination->textColor = source->textColor;
+            destination->fontId = source->fontId;
+            destination->fontSize = source->fontSize;
+            destination->letterSpacing = source->letterSpacing;
+            destination->lineHeight = source->lineHeight;
+            destination->wrapMode = source->wrapMode;
+            #ifdef CLAY_EXTEND_CONFIG_TEXT
+            CLAY__COPY_CONFIG_EXTENSION(destination, source, Clay_TextElementConfig, wrapMode);
+            #endif
+            break;
+        }
+        case CLAY__ELEMENT_CONFIG_TYPE_IMAGE: {
+            const Clay_ImageElementConfig *source = (const Clay_ImageElementConfig *)config;
+            Clay_ImageElementConfig *destination = &canonical->imageElementConfig;
+            destination->imageData = source->imageData;
+            destination->sourceDimensions = source->sourceDimensions;
+            #ifdef CLAY_EXTEND_CONFIG_IMAGE
+            CLAY__COPY_CONFIG_EXTENSION(destination, source, Clay_ImageElementConfig, sourceDimensions);
+            #endif
+            break;
+        }
+        case CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER: {
+            const Clay_FloatingElementConfig *source = (const Clay_FloatingElementConfig *)config;
+            Clay_FloatingElementConfig *destination = &canonical->floatingElementConfig;
+            destination->offset = source->offset;
+            destination->expand = source->expand;
+            destination->zIndex = source->zIndex;
+            destination->parentId = source->parentId;
+            destination->attachment.element = source->attachment.element;
+            destination->attachment.parent = source->attachment.parent;
+            destination->pointerCaptureMode = source->pointerCaptureMode;
+            break;
+        }
+        case CLAY__ELEMENT_CONFIG_TYPE_CUSTOM: {
+            #ifdef CLAY_EXTEND_CONFIG_CUSTOM
+            Clay__CopyConfigBytes(&canonical->customElementConfig, config, sizeof(Clay_CustomElementConfig));
+            #else
+            canonical->customElementConfig.customData = ((const Clay_CustomElementConfig *)config)->customData;
+            #endif
+            break;
+        }
+        case CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER: {
+            const Clay_ScrollElementConfig *source = (const Clay_ScrollElementConfig *)config;
+            Clay_ScrollElementConfig *destination = &canonical->scrollElementConfig;
+            destination->horizontal = source->horizontal;
+            destination->vertical = source->vertical;
+            destination->virtualItemCount = source->virtualItemCount;
+            destination->virtualItemSize = source->virtualItemSize;
+            break;
+        }
+        case CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER: {
+            // Clay_BorderElementConfig has no padding between its members
+            canonical->borderElementConfig = *(const Clay_BorderElementConfig *)config;
+            break;
+        }
+        default: {
+            const Clay_LayoutConfig *source = (const Clay_LayoutConfig *)config;
+            Clay_LayoutConfig *destination = &canonical->layoutConfig;
+            destination->sizing.width.size.minMax = source->sizing.width.size.minMax;
+            destination->sizing.width.type = source->sizing.width.type;
+            if (destination->sizing.width.type != CLAY__SIZING_TYPE_PERCENT && destination->sizing.width.size.minMax.max <= 0) {
+                destination->sizing.width.size.minMax.max = CLAY__MAXFLOAT;
+            }
+            destination->sizing.height.size.minMax = source->sizing.height.size.minMax;
+            destination->sizing.height.type = source->sizing.height.type;
+            if (destination->sizing.height.type != CLAY__SIZING_TYPE_PERCENT && destination->sizing.height.size.minMax.max <= 0) {
+                destination->sizing.height.size.minMax.max = CLAY__MAXFLOAT;
+            }
+            destination->padding.x = source->padding.x;
+            destination->padding.y = source->padding.y;
+            destination->childGap = source->childGap;
+            destination->childAlignment.x = source->childAlignment.x;
+            destination->childAlignment.y = source->childAlignment.y;
+            destination->layoutDirection = source->layoutDirection;
+            break;
+        }
+    }
+}
+
+// Returns the index slot holding a persisted config with the same bytes, or the empty slot where it would be inserted
+int32_t *Clay__FindPersistedConfigIndex(const void *config, uint32_t size, Clay__ElementConfigType type, uint32_t hash) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__int32_tArray *indices = &context->persistedConfigIndices;
+    uint32_t slotIndex = hash & (indices->capacity - 1);
+    while (indices->internalArray[slotIndex] != -1) {
+        Clay__PersistedConfig *persisted = &context->persistedConfigs.internalArray[indices->internalArray[slotIndex]];
+        if (persisted->hash == hash && persisted->type == type && Clay__ConfigBytesEqual(&persisted->config, config, size)) {
+            break;
+        }
+        slotIndex = (slotIndex + 1) & (indices->capacity - 1);
+    }
+    return &indices->internalArray[slotIndex];
 }
-Clay_LayoutConfig * Clay__StoreLayoutConfig(Clay_LayoutConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY_LAYOUT_DEFAULT : Clay__LayoutConfigArray_Add(&Clay__layoutConfigs, config); }
-Clay_RectangleElementConfig * Clay__StoreRectangleElementConfig(Clay_RectangleElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__RECTANGLE_ELEMENT_CONFIG_DEFAULT : Clay__RectangleElementConfigArray_Add(&Clay__rectangleElementConfigs, config); }
-Clay_TextElementConfig * Clay__StoreTextElementConfig(Clay_TextElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__TEXT_ELEMENT_CONFIG_DEFAULT : Clay__TextElementConfigArray_Add(&Clay__textElementConfigs, config); }
-Clay_ImageElementConfig * Clay__StoreImageElementConfig(Clay_ImageElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__IMAGE_ELEMENT_CONFIG_DEFAULT : Clay__ImageElementConfigArray_Add(&Clay__imageElementConfigs, config); }
-Clay_FloatingElementConfig * Clay__StoreFloatingElementConfig(Clay_FloatingElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__FLOATING_ELEMENT_CONFIG_DEFAULT : Clay__FloatingElementConfigArray_Add(&Clay__floatingElementConfigs, config); }
-Clay_CustomElementConfig * Clay__StoreCustomElementConfig(Clay_CustomElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__CUSTOM_ELEMENT_CONFIG_DEFAULT : Clay__CustomElementConfigArray_Add(&Clay__customElementConfigs, config); }
-Clay_ScrollElementConfig * Clay__StoreScrollElementConfig(Clay_ScrollElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__SCROLL_ELEMENT_CONFIG_DEFAULT : Clay__ScrollElementConfigArray_Add(&Clay__scrollElementConfigs, config); }
-Clay_BorderElementConfig * Clay__StoreBorderElementConfig(Clay_BorderElementConfig config) {  return Clay__booleanWarnings.maxElementsExceeded ? &CLAY__BORDER_ELEMENT_CONFIG_DEFAULT : Clay__BorderElementConfigArray_Add(&Clay__borderElementConfigs, config); }
+
+void *Clay__FindPersistedConfig(const void *config, uint32_t size, Clay__ElementConfigType type, uint32_t hash) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->persistedConfigs.length == 0) {
+        return CLAY__NULL;
+    }
+    int32_t index = *Clay__FindPersistedConfigIndex(config, size, type, hash);
+    return index == -1 ? CLAY__NULL : &context->persistedConfigs.internalArray[index].config;
+}
+
+void *Clay__PersistConfig(const void *config, Clay__ElementConfigType type) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ElementConfigValue canonical;
+    Clay__CanonicalizeElementConfig(&canonical, config, type);
+    uint32_t size = Clay__GetElementConfigStorage(type).itemSize;
+    uint32_t hash = Clay__HashConfigBytes(&canonical, size, type);
+    int32_t *index = Clay__FindPersistedConfigIndex(&canonical, size, type, hash);
+    if (*index != -1) {
+        return &context->persistedConfigs.internalArray[*index].config;
+    }
+    if (context->persistedConfigs.length == context->persistedConfigs.capacity) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay ran out of capacity while attempting to persist an element config. Try using Clay_SetMaxPersistedConfigCount() with a higher value."),
+            .userData = context->errorHandler.userData });
+        return CLAY__NULL;
+    }
+    *index = (int32_t)context->persistedConfigs.length;
+    Clay__PersistedConfig *persisted = Clay__PersistedConfigArray_Add(&context->persistedConfigs, CLAY__INIT(Clay__PersistedConfig) { .hash = hash, .type = type });
+    Clay__CopyConfigBytes(&persisted->config, &canonical, sizeof(Clay__ElementConfigValue));
+    return &persisted->config;
+}
+
+// Returns a stored copy of the config. Configs with the same members as one already stored this frame or persisted with
+// Clay_Persist*Config share the existing copy.
+void *Clay__StoreElementConfig(const void *config, Clay__ElementConfigType type) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ElementConfigStorage storage = Clay__GetElementConfigStorage(type);
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return storage.defaultConfig;
+    }
+    Clay__ElementConfigValue canonical;
+    Clay__CanonicalizeElementConfig(&canonical, config, type);
+    uint32_t hash = Clay__HashConfigBytes(&canonical, storage.itemSize, type);
+    Clay__ConfigInternSlot *slot = &context->configInternTable.internalArray[hash & (CLAY__CONFIG_INTERN_TABLE_SIZE - 1)];
+    if (slot->config && slot->hash == hash && slot->type == type && Clay__ConfigBytesEqual(slot->config, &canonical, storage.itemSize)) {
+        return slot->config;
+    }
+    void *storedConfig = Clay__FindPersistedConfig(&canonical, storage.itemSize, type, hash);
+    if (!storedConfig) {
+        if (!Clay__ElementCategoryCapacityCheck(*storage.length, storage.capacity, storage.capacityErrorText)) {
+            return storage.defaultConfig;
+        }
+        storedConfig = storage.internalArray + (*storage.length)++ * storage.itemSize;
+        Clay__CopyConfigBytes(storedConfig, &canonical, storage.itemSize);
+    }
+    *slot = CLAY__INIT(Clay__ConfigInternSlot) { .hash = hash, .type = type, .config = storedConfig };
+    return storedConfig;
+}
+
+Clay_LayoutConfig * Clay__StoreLayoutConfig(Clay_LayoutConfig config) { return (Clay_LayoutConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_NONE); }
+Clay_RectangleElementConfig * Clay__StoreRectangleElementConfig(Clay_RectangleElementConfig config) { return (Clay_RectangleElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE); }
+Clay_TextElementConfig * Clay__StoreTextElementConfig(Clay_TextElementConfig config) { return (Clay_TextElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_TEXT); }
+Clay_ImageElementConfig * Clay__StoreImageElementConfig(Clay_ImageElementConfig config) { return (Clay_ImageElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_IMAGE); }
+Clay_FloatingElementConfig * Clay__StoreFloatingElementConfig(Clay_FloatingElementConfig config) { return (Clay_FloatingElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER); }
+Clay_CustomElementConfig * Clay__StoreCustomElementConfig(Clay_CustomElementConfig config) { return (Clay_CustomElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_CUSTOM); }
+Clay_ScrollElementConfig * Clay__StoreScrollElementConfig(Clay_ScrollElementConfig config) { return (Clay_ScrollElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER); }
+Clay_BorderElementConfig * Clay__StoreBorderElementConfig(Clay_BorderElementConfig config) { return (Clay_BorderElementConfig *)Clay__StoreElementConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER); }
+
+CLAY_WASM_EXPORT("Clay_PersistLayoutConfig")
+Clay_LayoutConfig * Clay_PersistLayoutConfig(Clay_LayoutConfig config) { return (Clay_LayoutConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_NONE); }
+CLAY_WASM_EXPORT("Clay_PersistRectangleConfig")
+Clay_RectangleElementConfig * Clay_PersistRectangleConfig(Clay_RectangleElementConfig config) { return (Clay_RectangleElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE); }
+CLAY_WASM_EXPORT("Clay_PersistTextConfig")
+Clay_TextElementConfig * Clay_PersistTextConfig(Clay_TextElementConfig config) { return (Clay_TextElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_TEXT); }
+CLAY_WASM_EXPORT("Clay_PersistImageConfig")
+Clay_ImageElementConfig * Clay_PersistImageConfig(Clay_ImageElementConfig config) { return (Clay_ImageElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_IMAGE); }
+CLAY_WASM_EXPORT("Clay_PersistFloatingConfig")
+Clay_FloatingElementConfig * Clay_PersistFloatingConfig(Clay_FloatingElementConfig config) { return (Clay_FloatingElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER); }
+CLAY_WASM_EXPORT("Clay_PersistCustomConfig")
+Clay_CustomElementConfig * Clay_PersistCustomConfig(Clay_CustomElementConfig config) { return (Clay_CustomElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_CUSTOM); }
+CLAY_WASM_EXPORT("Clay_PersistScrollConfig")
+Clay_ScrollElementConfig * Clay_PersistScrollConfig(Clay_ScrollElementConfig config) { return (Clay_ScrollElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER); }
+CLAY_WASM_EXPORT("Clay_PersistBorderConfig")
+Clay_BorderElementConfig * Clay_PersistBorderConfig(Clay_BorderElementConfig config) { return (Clay_BorderElementConfig *)Clay__PersistConfig(&config, CLAY__ELEMENT_CONFIG_TYPE_BORDER_CONTAINER); }
 
 #pragma region DebugTools
 Clay_Color CLAY__DEBUGVIEW_COLOR_1 = {58, 56, 52, 255};
@@ -2955,7 +5284,8 @@ CLAY__TYPEDEF(Clay__RenderDebugLayoutData, struct {
 
 // Returns row count
 Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialRootsLength, int32_t highlightedRowIndex) {
-    Clay__int32_tArray dfsBuffer = Clay__reusableElementIndexBuffer;
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__int32_tArray dfsBuffer = context->reusableElementIndexBuffer;
     Clay__DebugView_ScrollViewItemLayoutConfig = CLAY__INIT(Clay_LayoutConfig) { .sizing = { .height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT) }, .childGap = 6, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }};
     Clay__RenderDebugLayoutData layoutData = {0};
 
@@ -2963,9 +5293,9 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
 
     for (int rootIndex = 0; rootIndex < initialRootsLength; ++rootIndex) {
         dfsBuffer.length = 0;
-        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&Clay__layoutElementTreeRoots, rootIndex);
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
         Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
-        Clay__treeNodeVisited.internalArray[0] = false;
+        context->treeNodeVisited.internalArray[0] = false;
         if (rootIndex > 0) {
             CLAY(CLAY_IDI("Clay__DebugView_EmptyRowOuter", rootIndex), CLAY_LAYOUT({ .sizing = {.width = CLAY_SIZING_GROW({0})}, .padding = {CLAY__DEBUGVIEW_INDENT_WIDTH / 2, 0} })) {
                 CLAY(CLAY_IDI("Clay__DebugView_EmptyRow", rootIndex), CLAY_LAYOUT({ .sizing = { .width = CLAY_SIZING_GROW({0}), .height = CLAY_SIZING_FIXED((float)CLAY__DEBUGVIEW_ROW_HEIGHT) }}), CLAY_BORDER({ .top = { .width = 1, .color = CLAY__DEBUGVIEW_COLOR_3 } })) {}
@@ -2974,8 +5304,8 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
         }
         while (dfsBuffer.length > 0) {
             uint32_t currentElementIndex = Clay__int32_tArray_Get(&dfsBuffer, (int)dfsBuffer.length - 1);
-            Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, (int)currentElementIndex);
-            if (Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
+            Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)currentElementIndex);
+            if (context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
                 if (!Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && currentElement->childrenOrTextContent.children.length > 0) {
                     Clay__CloseElement();
                     Clay__CloseElement();
@@ -2986,16 +5316,16 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
             }
 
             if (highlightedRowIndex == layoutData.rowCount) {
-                if (Clay__pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
-                    Clay__debugSelectedElementId = currentElement->id;
+                if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
+                    context->debugSelectedElementId = currentElement->id;
                 }
                 highlightedElementId = currentElement->id;
             }
 
-            Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
+            context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
             Clay_LayoutElementHashMapItem *currentElementData = Clay__GetHashMapItem(currentElement->id);
-            bool offscreen = Clay__ElementIsOffscreen(&currentElementData->boundingBox);
-            if (Clay__debugSelectedElementId == currentElement->id) {
+            bool offscreen = Clay__ElementIsOffscreen(&Clay__GetHashMapSlot(currentElement->id)->boundingBox);
+            if (context->debugSelectedElementId == currentElement->id) {
                 layoutData.selectedElementRowIndex = layoutData.rowCount;
             }
             CLAY(CLAY_IDI("Clay__DebugView_ElementOuter", currentElement->id), Clay__AttachLayoutConfig(&Clay__DebugView_ScrollViewItemLayoutConfig)) {
@@ -3025,7 +5355,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
                         }
                     }
                 }
-                Clay_String idString = Clay__layoutElementIdStrings.internalArray[currentElementIndex];
+                Clay_String idString = context->layoutElementIdStrings.internalArray[currentElementIndex];
                 if (idString.length > 0) {
                     CLAY_TEXT(idString, offscreen ? CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_3, .fontSize = 16 }) : &Clay__DebugView_TextNameConfig);
                 }
@@ -3071,16 +5401,16 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
             if (!(Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || (currentElementData && currentElementData->debugData->collapsed))) {
                 for (int i = currentElement->childrenOrTextContent.children.length - 1; i >= 0; --i) {
                     Clay__int32_tArray_Add(&dfsBuffer, currentElement->childrenOrTextContent.children.elements[i]);
-                    Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1] = false; // TODO needs to be ranged checked
+                    context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = false; // TODO needs to be ranged checked
                 }
             }
         }
     }
 
-    if (Clay__pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
+    if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
         Clay_ElementId collapseButtonId = Clay__HashString(CLAY_STRING("Clay__DebugView_CollapseElement"), 0, 0);
-        for (int i = (int)Clay__pointerOverIds.length - 1; i >= 0; i--) {
-            Clay_ElementId *elementId = Clay__ElementIdArray_Get(&Clay__pointerOverIds, i);
+        for (int i = (int)context->pointerOverIds.length - 1; i >= 0; i--) {
+            Clay_ElementId *elementId = Clay__ElementIdArray_Get(&context->pointerOverIds, i);
             if (elementId->baseId == collapseButtonId.baseId) {
                 Clay_LayoutElementHashMapItem *highlightedItem = Clay__GetHashMapItem(elementId->offset);
                 highlightedItem->debugData->collapsed = !highlightedItem->debugData->collapsed;
@@ -3179,49 +5509,46 @@ void Clay__RenderDebugViewBorder(int index, Clay_Border border, Clay_TextElement
 }
 
 void HandleDebugViewCloseButtonInteraction(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
     (void) elementId; (void) pointerInfo; (void) userData;
     if (pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
-        Clay__debugModeEnabled = false;
+        context->debugModeEnabled = false;
     }
 }
 
 void Clay__RenderDebugView(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
     Clay_ElementId closeButtonId = Clay__HashString(CLAY_STRING("Clay__DebugViewTopHeaderCloseButtonOuter"), 0, 0);
-    if (Clay__pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
-        for (uint32_t i = 0; i < Clay__pointerOverIds.length; ++i) {
-            Clay_ElementId *elementId = Clay__ElementIdArray_Get(&Clay__pointerOverIds, i);
+    if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
+        for (uint32_t i = 0; i < context->pointerOverIds.length; ++i) {
+            Clay_ElementId *elementId = Clay__ElementIdArray_Get(&context->pointerOverIds, i);
             if (elementId->id == closeButtonId.id) {
-                Clay__debugModeEnabled = false;
+                context->debugModeEnabled = false;
                 return;
             }
         }
     }
 
-    uint32_t initialRootsLength = Clay__layoutElementTreeRoots.length;
-    uint32_t initialElementsLength = Clay__layoutElements.length;
+    uint32_t initialRootsLength = context->layoutElementTreeRoots.length;
+    uint32_t initialElementsLength = context->layoutElements.length;
     Clay_TextElementConfig *infoTextConfig = CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_4, .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_NONE });
     Clay_TextElementConfig *infoTitleConfig = CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_3, .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_NONE });
     Clay_ElementId scrollId = Clay__HashString(CLAY_STRING("Clay__DebugViewOuterScrollPane"), 0, 0);
     float scrollYOffset = 0;
-    for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; ++i) {
-        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
-        if (scrollContainerData->elementId == scrollId.id) {
-            if (!Clay__externalScrollHandlingEnabled) {
-                scrollYOffset = scrollContainerData->scrollPosition.y;
-            }
-            break;
-        }
+    Clay__ScrollContainerDataInternal *scrollContainerData = Clay__GetScrollContainerData(scrollId.id);
+    if (scrollContainerData && !context->externalScrollHandlingEnabled) {
+        scrollYOffset = scrollContainerData->scrollPosition.y;
     }
-    int32_t highlightedRow = Clay__pointerInfo.position.y < Clay__layoutDimensions.height - 300
-            ? (int32_t)((Clay__pointerInfo.position.y - scrollYOffset) / (float)CLAY__DEBUGVIEW_ROW_HEIGHT) - 1
+    int32_t highlightedRow = context->pointerInfo.position.y < context->layoutDimensions.height - 300
+            ? (int32_t)((context->pointerInfo.position.y - scrollYOffset) / (float)CLAY__DEBUGVIEW_ROW_HEIGHT) - 1
             : -1;
-    if (Clay__pointerInfo.position.x < Clay__layoutDimensions.width - (float)Clay__debugViewWidth) {
+    if (context->pointerInfo.position.x < context->layoutDimensions.width - (float)Clay__debugViewWidth) {
         highlightedRow = -1;
     }
     Clay__RenderDebugLayoutData layoutData = {0};
     CLAY(CLAY_ID("Clay__DebugView"),
         CLAY_FLOATING({ .parentId = Clay__HashString(CLAY_STRING("Clay__RootContainer"), 0, 0).id, .attachment = { .element = CLAY_ATTACH_POINT_LEFT_CENTER, .parent = CLAY_ATTACH_POINT_RIGHT_CENTER }}),
-        CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED((float)Clay__debugViewWidth) , CLAY_SIZING_FIXED(Clay__layoutDimensions.height) }, .layoutDirection = CLAY_TOP_TO_BOTTOM }),
+        CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED((float)Clay__debugViewWidth) , CLAY_SIZING_FIXED(context->layoutDimensions.height) }, .layoutDirection = CLAY_TOP_TO_BOTTOM }),
         CLAY_BORDER({ .bottom = { .width = 1, .color = CLAY__DEBUGVIEW_COLOR_3 }})
     ) {
         CLAY(CLAY_LAYOUT({ .sizing = {CLAY_SIZING_GROW({0}), CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT)}, .padding = {CLAY__DEBUGVIEW_OUTER_PADDING, 0}, .childAlignment = {.y = CLAY_ALIGN_Y_CENTER} }), CLAY_RECTANGLE({ .color = CLAY__DEBUGVIEW_COLOR_2 })) {
@@ -3246,7 +5573,7 @@ void Clay__RenderDebugView(void) {
                         layoutData = Clay__RenderDebugLayoutElementsList((int32_t)initialRootsLength, highlightedRow);
                     }
                 }
-                float contentWidth = Clay__GetHashMapItem(panelContentsId.id)->layoutElement->dimensions.width;
+                float contentWidth = Clay__GetHashMapSlot(panelContentsId.id)->layoutElement->dimensions.width;
                 CLAY(CLAY_LAYOUT({ .sizing = {CLAY_SIZING_FIXED(contentWidth), {0}}, .layoutDirection = CLAY_TOP_TO_BOTTOM })) {}
                 for (uint32_t i = 0; i < layoutData.rowCount; i++) {
                     Clay_Color rowColor = (i & 1) == 0 ? CLAY__DEBUGVIEW_COLOR_2 : CLAY__DEBUGVIEW_COLOR_1;
@@ -3263,8 +5590,9 @@ void Clay__RenderDebugView(void) {
             }
         }
         CLAY(CLAY_LAYOUT({ .sizing = {.width = CLAY_SIZING_GROW({0}), .height = CLAY_SIZING_FIXED(1)} }), CLAY_RECTANGLE({ .color = CLAY__DEBUGVIEW_COLOR_3 })) {}
-        if (Clay__debugSelectedElementId != 0) {
-            Clay_LayoutElementHashMapItem *selectedItem = Clay__GetHashMapItem(Clay__debugSelectedElementId);
+        if (context->debugSelectedElementId != 0) {
+            Clay_LayoutElementHashMapItem *selectedItem = Clay__GetHashMapItem(context->debugSelectedElementId);
+            Clay__LayoutElementHashMapSlot *selectedSlot = Clay__GetHashMapSlot(context->debugSelectedElementId);
             CLAY(
                 CLAY_SCROLL({ .vertical = true }),
                 CLAY_LAYOUT({ .sizing = {CLAY_SIZING_GROW({0}), CLAY_SIZING_FIXED(300)}, .layoutDirection = CLAY_TOP_TO_BOTTOM }),
@@ -3289,18 +5617,18 @@ void Clay__RenderDebugView(void) {
                     CLAY_TEXT(CLAY_STRING("Bounding Box"), infoTitleConfig);
                     CLAY(CLAY_LAYOUT({0})) {
                         CLAY_TEXT(CLAY_STRING("{ x: "), infoTextConfig);
-                        CLAY_TEXT(Clay__IntToString(selectedItem->boundingBox.x), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(selectedSlot->boundingBox.x), infoTextConfig);
                         CLAY_TEXT(CLAY_STRING(", y: "), infoTextConfig);
-                        CLAY_TEXT(Clay__IntToString(selectedItem->boundingBox.y), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(selectedSlot->boundingBox.y), infoTextConfig);
                         CLAY_TEXT(CLAY_STRING(", width: "), infoTextConfig);
-                        CLAY_TEXT(Clay__IntToString(selectedItem->boundingBox.width), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(selectedSlot->boundingBox.width), infoTextConfig);
                         CLAY_TEXT(CLAY_STRING(", height: "), infoTextConfig);
-                        CLAY_TEXT(Clay__IntToString(selectedItem->boundingBox.height), infoTextConfig);
+                        CLAY_TEXT(Clay__IntToString(selectedSlot->boundingBox.height), infoTextConfig);
                         CLAY_TEXT(CLAY_STRING(" }"), infoTextConfig);
                     }
                     // .layoutDirection
                     CLAY_TEXT(CLAY_STRING("Layout Direction"), infoTitleConfig);
-                    Clay_LayoutConfig *layoutConfig = selectedItem->layoutElement->layoutConfig;
+                    Clay_LayoutConfig *layoutConfig = selectedSlot->layoutElement->layoutConfig;
                     CLAY_TEXT(layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM ? CLAY_STRING("TOP_TO_BOTTOM") : CLAY_STRING("LEFT_TO_RIGHT"), infoTextConfig);
                     // .sizing
                     CLAY_TEXT(CLAY_STRING("Sizing"), infoTitleConfig);
@@ -3346,8 +5674,8 @@ void Clay__RenderDebugView(void) {
                         CLAY_TEXT(CLAY_STRING(" }"), infoTextConfig);
                     }
                 }
-                for (uint32_t elementConfigIndex = 0; elementConfigIndex < selectedItem->layoutElement->elementConfigs.length; ++elementConfigIndex) {
-                    Clay_ElementConfig *elementConfig = Clay__ElementConfigArraySlice_Get(&selectedItem->layoutElement->elementConfigs, elementConfigIndex);
+                for (uint32_t elementConfigIndex = 0; elementConfigIndex < selectedSlot->layoutElement->elementConfigs.length; ++elementConfigIndex) {
+                    Clay_ElementConfig *elementConfig = Clay__ElementConfigArraySlice_Get(&selectedSlot->layoutElement->elementConfigs, elementConfigIndex);
                     Clay__RenderDebugViewElementConfigHeader(selectedItem->elementId.stringId, elementConfig->type);
                     switch (elementConfig->type) {
                         case CLAY__ELEMENT_CONFIG_TYPE_RECTANGLE: {
@@ -3489,9 +5817,9 @@ void Clay__RenderDebugView(void) {
                     CLAY_TEXT(CLAY_STRING("Warnings"), warningConfig);
                 }
                 CLAY(CLAY_ID("Clay__DebugViewWarningsTopBorder"), CLAY_LAYOUT({ .sizing = { .width = CLAY_SIZING_GROW({0}), .height = CLAY_SIZING_FIXED(1)} }), CLAY_RECTANGLE({ .color = {200, 200, 200, 255} })) {}
-                int previousWarningsLength = (int)Clay_warnings.length;
+                int previousWarningsLength = (int)context->warnings.length;
                 for (int i = 0; i < previousWarningsLength; i++) {
-                    Clay__Warning warning = Clay_warnings.internalArray[i];
+                    Clay__Warning warning = context->warnings.internalArray[i];
                     CLAY(CLAY_IDI("Clay__DebugViewWarningItem", i), CLAY_LAYOUT({ .sizing = {.height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT)}, .padding = {CLAY__DEBUGVIEW_OUTER_PADDING, 0}, .childGap = 8, .childAlignment = {.y = CLAY_ALIGN_Y_CENTER} })) {
                         CLAY_TEXT(warning.baseMessage, warningConfig);
                         if (warning.dynamicMessage.length > 0) {
@@ -3509,10 +5837,49 @@ void Clay__RenderDebugView(void) {
 
 CLAY_WASM_EXPORT("Clay_MinMemorySize")
 uint32_t Clay_MinMemorySize(void) {
-    Clay_Arena fakeArena = { .capacity = SIZE_MAX };
-    Clay__InitializePersistentMemory(&fakeArena);
-    Clay__InitializeEphemeralMemory(&fakeArena);
-    return fakeArena.nextAllocation;
+    Clay_Context fakeContext = {
+        .maxElementCount = Clay__defaultMaxElementCount,
+        .maxMeasureTextCacheWordCount = Clay__defaultMaxMeasureTextCacheWordCount,
+        .maxScrollContainerCount = Clay__defaultMaxScrollContainerCount,
+        .maxTextElementCount = Clay__defaultMaxTextElementCount,
+        .maxImageElementCount = Clay__defaultMaxImageElementCount,
+        .maxFloatingElementCount = Clay__defaultMaxFloatingElementCount,
+        .maxBorderElementCount = Clay__defaultMaxBorderElementCount,
+        .maxCustomElementCount = Clay__defaultMaxCustomElementCount,
+        .maxPersistedConfigCount = Clay__defaultMaxPersistedConfigCount,
+        .internalArena = { .capacity = SIZE_MAX },
+    };
+    // Reserve space for the context itself, which Clay_CreateContext places at the start of the arena
+    Clay__Array_Allocate_Arena(1, sizeof(Clay_Context), CLAY__ALIGNMENT(Clay_Context), &fakeContext.internalArena);
+    Clay__InitializePersistentMemory(&fakeContext);
+    Clay__InitializeEphemeralMemory(&fakeContext);
+    // The element hash map is aligned to a cache line, which can take up to 64 bytes more padding in a real arena than it
+    // does from the cache line aligned address the fake arena starts at
+    return fakeContext.internalArena.nextAllocation + 64;
+}
+
+CLAY_WASM_EXPORT("Clay_OptionalFeatureMemorySize")
+uint32_t Clay_OptionalFeatureMemorySize(void) {
+    Clay_Context fakeContext = {
+        .maxElementCount = Clay__defaultMaxElementCount,
+        .maxMeasureTextCacheWordCount = Clay__defaultMaxMeasureTextCacheWordCount,
+        .maxScrollContainerCount = Clay__defaultMaxScrollContainerCount,
+        .maxTextElementCount = Clay__defaultMaxTextElementCount,
+        .maxImageElementCount = Clay__defaultMaxImageElementCount,
+        .maxFloatingElementCount = Clay__defaultMaxFloatingElementCount,
+        .maxBorderElementCount = Clay__defaultMaxBorderElementCount,
+        .maxCustomElementCount = Clay__defaultMaxCustomElementCount,
+        .maxPersistedConfigCount = Clay__defaultMaxPersistedConfigCount,
+    };
+    // Each feature's memory starts at a cache line boundary, which can waste up to a cache line
+    uint32_t totalSize = 0;
+    void (*initializeFunctions[])(Clay_Context* context, Clay_Arena *arena) = { Clay__InitializeLayoutCacheMemory, Clay__InitializeWrappedTextCacheMemory, Clay__InitializeRenderCommandBatchMemory, Clay__InitializeRenderCommandDiffMemory };
+    for (uint32_t i = 0; i < sizeof(initializeFunctions) / sizeof(initializeFunctions[0]); ++i) {
+        Clay_Arena measureArena = { .capacity = SIZE_MAX };
+        initializeFunctions[i](&fakeContext, &measureArena);
+        totalSize += (uint32_t)measureArena.nextAllocation + 64;
+    }
+    return totalSize;
 }
 
 CLAY_WASM_EXPORT("Clay_CreateArenaWithCapacityAndMemory")
@@ -3524,6 +5891,111 @@ Clay_Arena Clay_CreateArenaWithCapacityAndMemory(uint32_t capacity, void *offset
     return arena;
 }
 
+CLAY_WASM_EXPORT("Clay_SetGlyphAdvanceTable")
+void Clay_SetGlyphAdvanceTable(Clay_GlyphAdvanceTable *table) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_TextElementConfig fontConfig = { .fontId = table->fontId, .fontSize = table->fontSize };
+    Clay__GlyphAdvanceTableEntry *entry = Clay__FindGlyphAdvanceTable(&fontConfig);
+    if (!entry) {
+        if (context->glyphAdvanceTables.length == context->glyphAdvanceTables.capacity) {
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay can only store 64 glyph advance tables, one for each combination of fontId and fontSize."),
+                .userData = context->errorHandler.userData });
+            return;
+        }
+        entry = Clay__GlyphAdvanceTableEntryArray_Add(&context->glyphAdvanceTables, CLAY__INIT(Clay__GlyphAdvanceTableEntry) {0});
+    }
+    *entry = CLAY__INIT(Clay__GlyphAdvanceTableEntry) { .table = table };
+    for (uint32_t i = 0; i < table->kerningPairCount; ++i) {
+        uint8_t first = table->kerningPairs[i].first;
+        entry->kerningFirstMask[first >> 5] |= 1u << (first & 31);
+    }
+}
+
+// Snapshot layout: magic, version, font fingerprint and entry count, followed by the id, length, check hash, width and
+// height of each cached word. Values are stored in native byte order, so a snapshot from a machine of the other endianness fails the
+// magic check rather than loading garbage.
+#define CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_MAGIC 0x59414c43
+#define CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_VERSION 2
+#define CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE 16
+#define CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_ENTRY_SIZE 20
+
+void Clay__CopyBytes(void *destination, const void *source, uint32_t length) {
+    for (uint32_t i = 0; i < length; ++i) {
+        ((uint8_t *)destination)[i] = ((const uint8_t *)source)[i];
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SaveMeasureTextCache")
+uint32_t Clay_SaveMeasureTextCache(uint32_t fontFingerprint, void *buffer, uint32_t bufferSize) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t snapshotSize = CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE + context->measuredWordCacheCount * CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_ENTRY_SIZE;
+    if (buffer == CLAY__NULL || bufferSize < snapshotSize) {
+        return snapshotSize;
+    }
+    uint32_t header[4] = { CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_MAGIC, CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_VERSION, fontFingerprint, context->measuredWordCacheCount };
+    uint8_t *output = (uint8_t *)buffer;
+    Clay__CopyBytes(output, header, CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE);
+    output += CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE;
+    for (uint32_t i = 0; i < context->measuredWordCache.capacity; ++i) {
+        Clay__MeasuredWordCacheEntry *entry = &context->measuredWordCache.internalArray[i];
+        if (entry->key.id == 0) {
+            continue;
+        }
+        Clay__CopyBytes(output, &entry->key.id, 4);
+        Clay__CopyBytes(output + 4, &entry->key.length, 4);
+        Clay__CopyBytes(output + 8, &entry->key.checkHash, 4);
+        Clay__CopyBytes(output + 12, &entry->dimensions.width, 4);
+        Clay__CopyBytes(output + 16, &entry->dimensions.height, 4);
+        output += CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_ENTRY_SIZE;
+    }
+    return snapshotSize;
+}
+
+CLAY_WASM_EXPORT("Clay_LoadMeasureTextCache")
+bool Clay_LoadMeasureTextCache(uint32_t fontFingerprint, const void *data, uint32_t dataSize) {
+    if (data == CLAY__NULL || dataSize < CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE) {
+        return false;
+    }
+    uint32_t header[4];
+    const uint8_t *input = (const uint8_t *)data;
+    Clay__CopyBytes(header, input, CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE);
+    if (header[0] != CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_MAGIC || header[1] != CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_VERSION || header[2] != fontFingerprint) {
+        return false;
+    }
+    uint32_t entryCount = header[3];
+    if (entryCount > (dataSize - CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE) / CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_ENTRY_SIZE) {
+        return false;
+    }
+    input += CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_HEADER_SIZE;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        Clay__MeasuredWordKey key;
+        Clay_Dimensions dimensions;
+        Clay__CopyBytes(&key.id, input, 4);
+        Clay__CopyBytes(&key.length, input + 4, 4);
+        Clay__CopyBytes(&key.checkHash, input + 8, 4);
+        Clay__CopyBytes(&dimensions.width, input + 12, 4);
+        Clay__CopyBytes(&dimensions.height, input + 16, 4);
+        // The key is stored whole, so a loaded word is only ever used for a word whose id, length and check hash all match
+        if (key.id != 0) {
+            Clay__StoreMeasuredWordDimensions(key, dimensions);
+        }
+        input += CLAY__MEASURE_TEXT_CACHE_SNAPSHOT_ENTRY_SIZE;
+    }
+    return true;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMeasureTextBatchFunction")
+void Clay_SetMeasureTextBatchFunction(void (*measureTextBatchFunction)(Clay_MeasureTextBatchItem *items, uint32_t itemCount, Clay_Dimensions *dimensions)) {
+    Clay__MeasureTextBatch = measureTextBatchFunction;
+}
+
+CLAY_WASM_EXPORT("Clay_SetParallelForFunction")
+void Clay_SetParallelForFunction(void (*parallelForFunction)(uint32_t jobCount, void (*job)(uint32_t jobIndex, void *jobData), void *jobData)) {
+    Clay__ParallelFor = parallelForFunction;
+}
+
 #ifndef CLAY_WASM
 void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_String *text, Clay_TextElementConfig *config)) {
     Clay__MeasureText = measureTextFunction;
@@ -3535,56 +6007,53 @@ void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)
 
 CLAY_WASM_EXPORT("Clay_SetLayoutDimensions")
 void Clay_SetLayoutDimensions(Clay_Dimensions dimensions) {
-    Clay__layoutDimensions = dimensions;
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->layoutDimensions = dimensions;
 }
 
 CLAY_WASM_EXPORT("Clay_SetPointerState")
 void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return;
     }
-    Clay__pointerInfo.position = position;
-    Clay__pointerOverIds.length = 0;
-    Clay__int32_tArray dfsBuffer = Clay__layoutElementChildrenBuffer;
-    for (int rootIndex = Clay__layoutElementTreeRoots.length - 1; rootIndex >= 0; --rootIndex) {
-        dfsBuffer.length = 0;
-        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&Clay__layoutElementTreeRoots, rootIndex);
-        Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
-        Clay__treeNodeVisited.internalArray[0] = false;
+    context->pointerInfo.position = position;
+    context->pointerOverIds.length = 0;
+    for (int rootIndex = context->layoutElementTreeRoots.length - 1; rootIndex >= 0; --rootIndex) {
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        if (root->hitTestNodeIndex >= context->hitTestNodes.length) {
+            continue; // The layout hasn't been positioned yet
+        }
         bool found = false;
-        while (dfsBuffer.length > 0) {
-            if (Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
-                dfsBuffer.length--;
+        // Walk the hit test hierarchy in depth first order, skipping any subtree that can't contain the pointer
+        uint32_t nodeIndex = root->hitTestNodeIndex;
+        uint32_t rootEndIndex = context->hitTestNodes.internalArray[nodeIndex].subtreeEndIndex;
+        while (nodeIndex < rootEndIndex) {
+            Clay__HitTestNode *hitTestNode = &context->hitTestNodes.internalArray[nodeIndex];
+            if (position.x < hitTestNode->subtreeMin.x || position.x > hitTestNode->subtreeMax.x || position.y < hitTestNode->subtreeMin.y || position.y > hitTestNode->subtreeMax.y) {
+                nodeIndex = hitTestNode->subtreeEndIndex;
                 continue;
             }
-            Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
-            Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, Clay__int32_tArray_Get(&dfsBuffer, (int)dfsBuffer.length - 1));
-            Clay_LayoutElementHashMapItem *mapItem = Clay__GetHashMapItem(currentElement->id); // TODO think of a way around this, maybe the fact that it's essentially a binary tree limits the cost, but the worst case is not great
-            Clay_BoundingBox elementBox = mapItem->boundingBox;
-            elementBox.x -= root->pointerOffset.x;
-            elementBox.y -= root->pointerOffset.y;
-            if (mapItem) {
-                if ((Clay__PointIsInsideRect(position, elementBox))) {
-                    if (mapItem->onHoverFunction) {
-                        mapItem->onHoverFunction(mapItem->elementId, Clay__pointerInfo, mapItem->hoverFunctionUserData);
-                    }
-                    Clay__ElementIdArray_Add(&Clay__pointerOverIds, mapItem->elementId);
-                    found = true;
-                }
-                if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
-                    dfsBuffer.length--;
-                    continue;
-                }
-                for (int i = currentElement->childrenOrTextContent.children.length - 1; i >= 0; --i) {
-                    Clay__int32_tArray_Add(&dfsBuffer, currentElement->childrenOrTextContent.children.elements[i]);
-                    Clay__treeNodeVisited.internalArray[dfsBuffer.length - 1] = false; // TODO needs to be ranged checked
+            if (hitTestNode->hashMapSlotIndex == UINT32_MAX) {
+                nodeIndex++;
+                continue;
+            }
+            Clay__LayoutElementHashMapSlot *hashMapSlot = &context->layoutElementsHashMap.internalArray[hitTestNode->hashMapSlotIndex];
+            Clay_BoundingBox hitTestBoundingBox = hashMapSlot->boundingBox;
+            hitTestBoundingBox.x -= root->pointerOffset.x;
+            hitTestBoundingBox.y -= root->pointerOffset.y;
+            if (Clay__PointIsInsideRect(position, hitTestBoundingBox)) {
+                Clay_LayoutElementHashMapItem *mapItem = Clay__GetHashMapSlotItem(hashMapSlot);
+                if (mapItem->onHoverFunction) {
+                    mapItem->onHoverFunction(mapItem->elementId, context->pointerInfo, mapItem->hoverFunctionUserData);
                 }
-            } else {
-                dfsBuffer.length--;
+                Clay__ElementIdArray_Add(&context->pointerOverIds, mapItem->elementId);
+                found = true;
             }
+            nodeIndex++;
         }
 
-        Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&Clay__layoutElements, root->layoutElementIndex);
+        Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, root->layoutElementIndex);
         if (found && Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER) &&
                 Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING_CONTAINER).floatingElementConfig->pointerCaptureMode == CLAY_POINTER_CAPTURE_MODE_CAPTURE) {
             break;
@@ -3592,53 +6061,104 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
     }
 
     if (isPointerDown) {
-        if (Clay__pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
-            Clay__pointerInfo.state = CLAY_POINTER_DATA_PRESSED;
-        } else if (Clay__pointerInfo.state != CLAY_POINTER_DATA_PRESSED) {
-            Clay__pointerInfo.state = CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
+        if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
+            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED;
+        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_PRESSED) {
+            context->pointerInfo.state = CLAY_POINTER_DATA_PRESSED_THIS_FRAME;
         }
     } else {
-        if (Clay__pointerInfo.state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
-            Clay__pointerInfo.state = CLAY_POINTER_DATA_RELEASED;
-        } else if (Clay__pointerInfo.state != CLAY_POINTER_DATA_RELEASED)  {
-            Clay__pointerInfo.state = CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
+        if (context->pointerInfo.state == CLAY_POINTER_DATA_RELEASED_THIS_FRAME) {
+            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED;
+        } else if (context->pointerInfo.state != CLAY_POINTER_DATA_RELEASED)  {
+            context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
         }
     }
 }
 
-CLAY_WASM_EXPORT("Clay_Initialize")
-void Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler) {
-    Clay__internalArena = arena;
-    Clay__InitializePersistentMemory(&Clay__internalArena);
-    Clay__InitializeEphemeralMemory(&Clay__internalArena);
-    for (uint32_t i = 0; i < Clay__layoutElementsHashMap.capacity; ++i) {
-        Clay__layoutElementsHashMap.internalArray[i] = -1;
+CLAY_WASM_EXPORT("Clay_CreateContext")
+Clay_Context* Clay_CreateContext(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler) {
+    // The context lives at the start of the arena it manages, so no memory is allocated outside of it. No context is current
+    // while it is allocated, so that a failure isn't reported to the error handler of some other context.
+    if (!errorHandler.errorHandlerFunction) {
+        errorHandler = CLAY__INIT(Clay_ErrorHandler) { .errorHandlerFunction = Clay__ErrorHandlerFunctionDefault };
+    }
+    Clay_Context *previousContext = Clay_GetCurrentContext();
+    Clay_SetCurrentContext(CLAY__NULL);
+    Clay_Context *context = (Clay_Context *)Clay__Array_Allocate_Arena(1, sizeof(Clay_Context), CLAY__ALIGNMENT(Clay_Context), &arena);
+    if (context == CLAY__NULL) {
+        Clay_SetCurrentContext(previousContext);
+        errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay attempted to allocate memory in its arena, but ran out of capacity. Try increasing the capacity of the arena passed to Clay_Initialize()"),
+            .userData = errorHandler.userData });
+        return CLAY__NULL;
+    }
+    *context = CLAY__INIT(Clay_Context) {
+        .maxElementCount = Clay__defaultMaxElementCount,
+        .maxMeasureTextCacheWordCount = Clay__defaultMaxMeasureTextCacheWordCount,
+        .maxScrollContainerCount = Clay__defaultMaxScrollContainerCount,
+        .maxTextElementCount = Clay__defaultMaxTextElementCount,
+        .maxImageElementCount = Clay__defaultMaxImageElementCount,
+        .maxFloatingElementCount = Clay__defaultMaxFloatingElementCount,
+        .maxBorderElementCount = Clay__defaultMaxBorderElementCount,
+        .maxCustomElementCount = Clay__defaultMaxCustomElementCount,
+        .maxPersistedConfigCount = Clay__defaultMaxPersistedConfigCount,
+        .warningsEnabled = true,
+        .errorHandler = errorHandler,
+        .pointerInfo = { .position = {-1, -1} },
+        .layoutDimensions = layoutDimensions,
+        .dynamicElementIndexBaseHash = { .id = 128476991, .stringId = { .length = 8, .chars = "Auto ID" } },
+        .internalArena = arena,
+    };
+    // Errors raised while allocating are routed through the new context's error handler
+    Clay_SetCurrentContext(context);
+    Clay__InitializePersistentMemory(context);
+    Clay__InitializeEphemeralMemory(context);
+    for (uint32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
+        context->layoutElementsHashMap.internalArray[i] = CLAY__LAYOUT_ELEMENT_HASH_MAP_SLOT_DEFAULT;
+    }
+    for (uint32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
+        context->measureTextHashMap.internalArray[i] = 0;
     }
-    for (uint32_t i = 0; i < Clay__measureTextHashMap.capacity; ++i) {
-        Clay__measureTextHashMap.internalArray[i] = 0;
+    for (uint32_t i = 0; i < context->scrollContainerDataIndices.capacity; ++i) {
+        context->scrollContainerDataIndices.internalArray[i] = -1;
     }
-    Clay__measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
-    Clay__layoutDimensions = layoutDimensions;
-    Clay__errorHandler = errorHandler;
+    for (uint32_t i = 0; i < context->measuredWordOwners.capacity; ++i) {
+        context->measuredWordOwners.internalArray[i] = -1;
+    }
+    for (uint32_t i = 0; i < context->persistedConfigIndices.capacity; ++i) {
+        context->persistedConfigIndices.internalArray[i] = -1;
+    }
+    Clay__ClearMeasuredWordCache();
+    context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
+    Clay_SetCurrentContext(previousContext);
+    return context;
+}
+
+CLAY_WASM_EXPORT("Clay_Initialize")
+Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler) {
+    Clay_Context *context = Clay_CreateContext(arena, layoutDimensions, errorHandler);
+    Clay_SetCurrentContext(context);
+    return context;
 }
 
 CLAY_WASM_EXPORT("Clay_UpdateScrollContainers")
 void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDelta, float deltaTime) {
-    bool isPointerActive = enableDragScrolling && (Clay__pointerInfo.state == CLAY_POINTER_DATA_PRESSED || Clay__pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME);
-    // Don't apply scroll events to ancestors of the inner element
-    int32_t highestPriorityElementIndex = -1;
-    Clay__ScrollContainerDataInternal *highestPriorityScrollData = CLAY__NULL;
-    for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; i++) {
-        Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->scrollAnimationActive = false;
+    bool isPointerActive = enableDragScrolling && (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED || context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME);
+    uint32_t initialScrollContainerCount = context->scrollContainerDatas.length;
+    for (uint32_t i = 0; i < context->scrollContainerDatas.length; i++) {
+        Clay__ScrollContainerDataInternal *scrollData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
         if (!scrollData->openThisFrame) {
-            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&Clay__scrollContainerDatas, i);
+            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, i);
             continue;
         }
         scrollData->openThisFrame = false;
         Clay_LayoutElementHashMapItem *hashMapItem = Clay__GetHashMapItem(scrollData->elementId);
         // Element isn't rendered this frame but scroll offset has been retained
         if (!hashMapItem) {
-            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&Clay__scrollContainerDatas, i);
+            Clay__ScrollContainerDataInternalArray_RemoveSwapback(&context->scrollContainerDatas, i);
             continue;
         }
 
@@ -3660,6 +6180,7 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
         }
 
         // Apply existing momentum
+        Clay_Vector2 previousScrollPosition = scrollData->scrollPosition;
         scrollData->scrollPosition.x += scrollData->scrollMomentum.x;
         scrollData->scrollMomentum.x *= 0.95f;
         bool scrollOccurred = scrollDelta.x != 0 || scrollDelta.y != 0;
@@ -3674,16 +6195,24 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
             scrollData->scrollMomentum.y = 0;
         }
         scrollData->scrollPosition.y = CLAY__MIN(CLAY__MAX(scrollData->scrollPosition.y, -(CLAY__MAX(scrollData->contentSize.height - scrollData->layoutElement->dimensions.height, 0))), 0);
-
-        for (uint32_t j = 0; j < Clay__pointerOverIds.length; ++j) { // TODO n & m are small here but this being n*m gives me the creeps
-            if (scrollData->layoutElement->id == Clay__ElementIdArray_Get(&Clay__pointerOverIds, j)->id) {
-                highestPriorityElementIndex = j;
-                highestPriorityScrollData = scrollData;
-            }
+        // Remaining momentum will be applied by the next call, so the following frames will change without any input.
+        // Momentum pushing against the edge of the content doesn't move anything, so it isn't counted.
+        bool momentumMoved = scrollData->scrollPosition.x != previousScrollPosition.x || scrollData->scrollPosition.y != previousScrollPosition.y;
+        if (momentumMoved && (scrollData->scrollMomentum.x != 0 || scrollData->scrollMomentum.y != 0)) {
+            context->scrollAnimationActive = true;
         }
     }
+    if (context->scrollContainerDatas.length != initialScrollContainerCount) {
+        Clay__RebuildScrollContainerDataIndices();
+    }
+
+    // Don't apply scroll events to ancestors of the inner element
+    Clay__ScrollContainerDataInternal *highestPriorityScrollData = CLAY__NULL;
+    for (int32_t i = (int32_t)context->pointerOverIds.length - 1; i >= 0 && !highestPriorityScrollData; --i) {
+        highestPriorityScrollData = Clay__GetScrollContainerData(Clay__ElementIdArray_Get(&context->pointerOverIds, i)->id);
+    }
 
-    if (highestPriorityElementIndex > -1 && highestPriorityScrollData) {
+    if (highestPriorityScrollData) {
         Clay_LayoutElement *scrollElement = highestPriorityScrollData->layoutElement;
         Clay_ScrollElementConfig *scrollConfig = Clay__FindElementConfigWithType(scrollElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig;
         bool canScrollVertically = scrollConfig->vertical && highestPriorityScrollData->contentSize.height > scrollElement->dimensions.height;
@@ -3699,26 +6228,26 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
         if (isPointerActive) {
             highestPriorityScrollData->scrollMomentum = CLAY__INIT(Clay_Vector2){0};
             if (!highestPriorityScrollData->pointerScrollActive) {
-                highestPriorityScrollData->pointerOrigin = Clay__pointerInfo.position;
+                highestPriorityScrollData->pointerOrigin = context->pointerInfo.position;
                 highestPriorityScrollData->scrollOrigin = highestPriorityScrollData->scrollPosition;
                 highestPriorityScrollData->pointerScrollActive = true;
             } else {
                 float scrollDeltaX = 0, scrollDeltaY = 0;
                 if (canScrollHorizontally) {
                     float oldXScrollPosition = highestPriorityScrollData->scrollPosition.x;
-                    highestPriorityScrollData->scrollPosition.x = highestPriorityScrollData->scrollOrigin.x + (Clay__pointerInfo.position.x - highestPriorityScrollData->pointerOrigin.x);
+                    highestPriorityScrollData->scrollPosition.x = highestPriorityScrollData->scrollOrigin.x + (context->pointerInfo.position.x - highestPriorityScrollData->pointerOrigin.x);
                     highestPriorityScrollData->scrollPosition.x = CLAY__MAX(CLAY__MIN(highestPriorityScrollData->scrollPosition.x, 0), -(highestPriorityScrollData->contentSize.width - highestPriorityScrollData->boundingBox.width));
                     scrollDeltaX = highestPriorityScrollData->scrollPosition.x - oldXScrollPosition;
                 }
                 if (canScrollVertically) {
                     float oldYScrollPosition = highestPriorityScrollData->scrollPosition.y;
-                    highestPriorityScrollData->scrollPosition.y = highestPriorityScrollData->scrollOrigin.y + (Clay__pointerInfo.position.y - highestPriorityScrollData->pointerOrigin.y);
+                    highestPriorityScrollData->scrollPosition.y = highestPriorityScrollData->scrollOrigin.y + (context->pointerInfo.position.y - highestPriorityScrollData->pointerOrigin.y);
                     highestPriorityScrollData->scrollPosition.y = CLAY__MAX(CLAY__MIN(highestPriorityScrollData->scrollPosition.y, 0), -(highestPriorityScrollData->contentSize.height - highestPriorityScrollData->boundingBox.height));
                     scrollDeltaY = highestPriorityScrollData->scrollPosition.y - oldYScrollPosition;
                 }
                 if (scrollDeltaX > -0.1f && scrollDeltaX < 0.1f && scrollDeltaY > -0.1f && scrollDeltaY < 0.1f && highestPriorityScrollData->momentumTime > 0.15f) {
                     highestPriorityScrollData->momentumTime = 0;
-                    highestPriorityScrollData->pointerOrigin = Clay__pointerInfo.position;
+                    highestPriorityScrollData->pointerOrigin = context->pointerInfo.position;
                     highestPriorityScrollData->scrollOrigin = highestPriorityScrollData->scrollPosition;
                 } else {
                      highestPriorityScrollData->momentumTime += deltaTime;
@@ -3737,41 +6266,599 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
 
 CLAY_WASM_EXPORT("Clay_BeginLayout")
 void Clay_BeginLayout(void) {
-    Clay__InitializeEphemeralMemory(&Clay__internalArena);
-    Clay__generation++;
-    Clay__dynamicElementIndex = 0;
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__InitializeEphemeralMemory(context);
+    for (uint32_t i = 0; i < context->configInternTable.capacity; ++i) {
+        context->configInternTable.internalArray[i] = CLAY__INIT(Clay__ConfigInternSlot) {0};
+    }
+    Clay__ClearMeasureTextBatchSlots();
+    context->generation++;
+    context->dynamicElementIndex = 0;
     // Set up the root container that covers the entire window
-    Clay_Dimensions rootDimensions = {Clay__layoutDimensions.width, Clay__layoutDimensions.height};
-    if (Clay__debugModeEnabled) {
+    Clay_Dimensions rootDimensions = {context->layoutDimensions.width, context->layoutDimensions.height};
+    if (context->debugModeEnabled) {
         rootDimensions.width -= (float)Clay__debugViewWidth;
     }
-    Clay__booleanWarnings.maxElementsExceeded = false;
-    Clay__booleanWarnings.maxTextMeasureCacheExceeded = false;
-    Clay__booleanWarnings.maxRenderCommandsExceeded = false;
+    context->booleanWarnings.maxElementsExceeded = false;
+    context->booleanWarnings.maxTextMeasureCacheExceeded = false;
+    context->booleanWarnings.maxRenderCommandsExceeded = false;
     Clay__OpenElement();
     CLAY_ID("Clay__RootContainer");
     CLAY_LAYOUT({ .sizing = {CLAY_SIZING_FIXED((rootDimensions.width)), CLAY_SIZING_FIXED(rootDimensions.height)} });
     Clay__ElementPostConfiguration();
-    Clay__int32_tArray_Add(&Clay__openLayoutElementStack, 0);
-    Clay__LayoutElementTreeRootArray_Add(&Clay__layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) { .layoutElementIndex = 0 });
+    Clay__int32_tArray_Add(&context->openLayoutElementStack, 0);
+    Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) { .layoutElementIndex = 0 });
+}
+
+uint32_t Clay__HashPointer(uint32_t hash, const void *pointer) {
+    uint64_t value = (uint64_t)(uintptr_t)pointer;
+    hash = Clay__HashLayoutValue(hash, (uint32_t)value);
+    return Clay__HashLayoutValue(hash, (uint32_t)(value >> 32));
+}
+
+uint32_t Clay__HashColor(uint32_t hash, Clay_Color color) {
+    hash = Clay__HashLayoutFloat(hash, color.r);
+    hash = Clay__HashLayoutFloat(hash, color.g);
+    hash = Clay__HashLayoutFloat(hash, color.b);
+    return Clay__HashLayoutFloat(hash, color.a);
+}
+
+uint32_t Clay__HashCornerRadius(uint32_t hash, Clay_CornerRadius cornerRadius) {
+    hash = Clay__HashLayoutFloat(hash, cornerRadius.topLeft);
+    hash = Clay__HashLayoutFloat(hash, cornerRadius.topRight);
+    hash = Clay__HashLayoutFloat(hash, cornerRadius.bottomLeft);
+    return Clay__HashLayoutFloat(hash, cornerRadius.bottomRight);
+}
+
+uint32_t Clay__HashBorder(uint32_t hash, Clay_Border border) {
+    hash = Clay__HashLayoutValue(hash, border.width);
+    return Clay__HashColor(hash, border.color);
+}
+
+// Configs are hashed member by member rather than as raw bytes, because the padding between members isn't guaranteed to be
+// the same for two otherwise identical configs
+uint32_t Clay__HashRenderCommandContent(Clay_RenderCommand *renderCommand) {
+    uint32_t hash = Clay__HashLayoutValue(0, renderCommand->commandType);
+    switch (renderCommand->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            Clay_RectangleElementConfig *config = renderCommand->config.rectangleElementConfig;
+            hash = Clay__HashColor(hash, config->color);
+            hash = Clay__HashCornerRadius(hash, config->cornerRadius);
+            #ifdef CLAY_EXTEND_CONFIG_RECTANGLE
+            hash = CLAY__HASH_CONFIG_EXTENSION(hash, config, Clay_RectangleElementConfig, cornerRadius);
+            #endif
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_BorderElementConfig *config = renderCommand->config.borderElementConfig;
+            hash = Clay__HashBorder(hash, config->left);
+            hash = Clay__HashBorder(hash, config->right);
+            hash = Clay__HashBorder(hash, config->top);
+            hash = Clay__HashBorder(hash, config->bottom);
+            hash = Clay__HashBorder(hash, config->betweenChildren);
+            hash = Clay__HashCornerRadius(hash, config->cornerRadius);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            Clay_TextElementConfig *config = renderCommand->config.textElementConfig;
+            hash = Clay__HashColor(hash, config->textColor);
+            hash = Clay__HashLayoutValue(hash, config->fontId);
+            hash = Clay__HashLayoutValue(hash, config->fontSize);
+            hash = Clay__HashLayoutValue(hash, config->letterSpacing);
+            hash = Clay__HashLayoutValue(hash, config->lineHeight);
+            hash = Clay__HashLayoutValue(hash, config->wrapMode);
+            #ifdef CLAY_EXTEND_CONFIG_TEXT
+            hash = CLAY__HASH_CONFIG_EXTENSION(hash, config, Clay_TextElementConfig, wrapMode);
+            #endif
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            Clay_ImageElementConfig *config = renderCommand->config.imageElementConfig;
+            hash = Clay__HashPointer(hash, config->imageData);
+            hash = Clay__HashLayoutFloat(hash, config->sourceDimensions.width);
+            hash = Clay__HashLayoutFloat(hash, config->sourceDimensions.height);
+            #ifdef CLAY_EXTEND_CONFIG_IMAGE
+            hash = CLAY__HASH_CONFIG_EXTENSION(hash, config, Clay_ImageElementConfig, sourceDimensions);
+            #endif
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+            Clay_ScrollElementConfig *config = renderCommand->config.scrollElementConfig;
+            hash = Clay__HashLayoutValue(hash, config->horizontal);
+            hash = Clay__HashLayoutValue(hash, config->vertical);
+            hash = Clay__HashLayoutValue(hash, config->virtualItemCount);
+            hash = Clay__HashLayoutFloat(hash, config->virtualItemSize);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+            Clay_CustomElementConfig *config = renderCommand->config.customElementConfig;
+            #ifdef CLAY_EXTEND_CONFIG_CUSTOM
+            hash = Clay__HashBytes(hash, (const uint8_t *)config, sizeof(Clay_CustomElementConfig));
+            #else
+            hash = Clay__HashPointer(hash, config->customData);
+            #endif
+            break;
+        }
+        default: break;
+    }
+    for (size_t i = 0; i < renderCommand->text.length; i++) {
+        hash = Clay__HashLayoutValue(hash, (uint8_t)renderCommand->text.chars[i]);
+    }
+    hash = Clay__HashLayoutValue(hash, (uint32_t)renderCommand->text.length);
+
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash;
+}
+
+// A hash of everything that affects how the frame looks, used to detect frames that are identical to the previous one
+uint32_t Clay__HashRenderCommands(Clay_RenderCommandArray *renderCommands) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t hash = Clay__HashLayoutFloat(0, context->layoutDimensions.width);
+    hash = Clay__HashLayoutFloat(hash, context->layoutDimensions.height);
+    for (uint32_t i = 0; i < renderCommands->length; ++i) {
+        Clay_RenderCommand *renderCommand = &renderCommands->internalArray[i];
+        hash = Clay__HashLayoutValue(hash, renderCommand->id);
+        hash = Clay__HashLayoutValue(hash, Clay__HashRenderCommandContent(renderCommand));
+        hash = Clay__HashLayoutFloat(hash, renderCommand->boundingBox.x);
+        hash = Clay__HashLayoutFloat(hash, renderCommand->boundingBox.y);
+        hash = Clay__HashLayoutFloat(hash, renderCommand->boundingBox.width);
+        hash = Clay__HashLayoutFloat(hash, renderCommand->boundingBox.height);
+    }
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash;
 }
 
 Clay_TextElementConfig Clay__DebugView_ErrorTextConfig = {.textColor = {255, 0, 0, 255}, .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_NONE };
 
+// How many of the preceding commands each command is tested against for overlap when batching. Commands further back
+// are assumed to overlap, which keeps batching linear in the number of commands at the cost of some extra layers.
+#define CLAY__RENDER_COMMAND_BATCH_LOOKBACK 256
+#define CLAY__RENDER_COMMAND_BATCH_LAYER_SHIFT 40
+
+uint64_t Clay__RenderCommandBatchKey(Clay_RenderCommand *renderCommand) {
+    uint64_t key = (uint64_t)renderCommand->commandType << 32;
+    if (renderCommand->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+        key |= renderCommand->config.textElementConfig->fontId;
+    } else if (renderCommand->commandType == CLAY_RENDER_COMMAND_TYPE_IMAGE) {
+        // Different images sharing a hash are only batched less well, their order is still correct
+        uint64_t address = (uint64_t)(uintptr_t)renderCommand->config.imageElementConfig->imageData;
+        key |= (uint32_t)(address ^ (address >> 32));
+    }
+    return key;
+}
+
+bool Clay__BoundingBoxesOverlap(Clay_BoundingBox *a, Clay_BoundingBox *b) {
+    return a->x < b->x + b->width && b->x < a->x + a->width && a->y < b->y + b->height && b->y < a->y + a->height;
+}
+
+// Stable bottom up merge sort, leaving the result in items
+void Clay__SortRenderCommandBatchItems(Clay__RenderCommandBatchItem *items, Clay__RenderCommandBatchItem *scratch, uint32_t count) {
+    Clay__RenderCommandBatchItem *source = items;
+    Clay__RenderCommandBatchItem *destination = scratch;
+    for (uint32_t width = 1; width < count; width *= 2) {
+        for (uint32_t start = 0; start < count; start += width * 2) {
+            uint32_t middle = CLAY__MIN(start + width, count);
+            uint32_t end = CLAY__MIN(start + width * 2, count);
+            uint32_t left = start, right = middle;
+            for (uint32_t i = start; i < end; ++i) {
+                if (left < middle && (right >= end || source[left].sortKey <= source[right].sortKey)) {
+                    destination[i] = source[left++];
+                } else {
+                    destination[i] = source[right++];
+                }
+            }
+        }
+        Clay__RenderCommandBatchItem *swap = source;
+        source = destination;
+        destination = swap;
+    }
+    if (source != items) {
+        for (uint32_t i = 0; i < count; ++i) {
+            items[i] = source[i];
+        }
+    }
+}
+
+// Reorders the render commands from start up to but not including end. Each command is given the lowest layer that is
+// above every earlier command it overlaps, or level with it if they would be drawn in the same batch. Sorting by layer
+// then batch keeps every pair of overlapping commands in their original order.
+void Clay__BatchRenderCommandRange(uint32_t start, uint32_t end) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommand *renderCommands = context->renderCommands.internalArray;
+    Clay__RenderCommandBatchItem *items = context->renderCommandBatchItems.internalArray;
+    uint64_t keyMask = ((uint64_t)1 << CLAY__RENDER_COMMAND_BATCH_LAYER_SHIFT) - 1;
+    uint64_t minimumLayer = 0;
+    for (uint32_t j = start; j < end; ++j) {
+        uint64_t key = Clay__RenderCommandBatchKey(&renderCommands[j]);
+        uint32_t windowStart = start;
+        if (j - start > CLAY__RENDER_COMMAND_BATCH_LOOKBACK) {
+            windowStart = j - CLAY__RENDER_COMMAND_BATCH_LOOKBACK;
+            minimumLayer = CLAY__MAX(minimumLayer, (items[windowStart - 1 - start].sortKey >> CLAY__RENDER_COMMAND_BATCH_LAYER_SHIFT) + 1);
+        }
+        uint64_t layer = minimumLayer;
+        for (uint32_t i = j; i > windowStart; --i) {
+            Clay__RenderCommandBatchItem *previous = &items[i - 1 - start];
+            if (Clay__BoundingBoxesOverlap(&renderCommands[i - 1].boundingBox, &renderCommands[j].boundingBox)) {
+                uint64_t previousLayer = previous->sortKey >> CLAY__RENDER_COMMAND_BATCH_LAYER_SHIFT;
+                layer = CLAY__MAX(layer, (previous->sortKey & keyMask) == key ? previousLayer : previousLayer + 1);
+            }
+        }
+        items[j - start] = CLAY__INIT(Clay__RenderCommandBatchItem) { (layer << CLAY__RENDER_COMMAND_BATCH_LAYER_SHIFT) | key, j };
+    }
+    uint32_t count = end - start;
+    Clay__SortRenderCommandBatchItems(items, context->renderCommandBatchScratch.internalArray, count);
+    // Move each command to its sorted position by following the cycles of the permutation
+    for (uint32_t i = 0; i < count; ++i) {
+        if (items[i].index == UINT32_MAX) {
+            continue;
+        }
+        Clay_RenderCommand first = renderCommands[start + i];
+        uint32_t destination = i;
+        while (true) {
+            uint32_t source = items[destination].index - start;
+            items[destination].index = UINT32_MAX;
+            if (source == i) {
+                renderCommands[start + destination] = first;
+                break;
+            }
+            renderCommands[start + destination] = renderCommands[start + source];
+            destination = source;
+        }
+    }
+}
+
+// Groups render commands of the same type, font and image together without changing the result of drawing them in
+// order. Scissor commands are left in place, so commands never move into or out of a scissor region.
+void Clay__BatchRenderCommands(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t rangeStart = 0;
+    for (uint32_t i = 0; i <= context->renderCommands.length; ++i) {
+        if (i < context->renderCommands.length) {
+            Clay_RenderCommandType commandType = context->renderCommands.internalArray[i].commandType;
+            if (commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START && commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+                continue;
+            }
+        }
+        if (i - rangeStart > 1) {
+            Clay__BatchRenderCommandRange(rangeStart, i);
+        }
+        rangeStart = i + 1;
+    }
+}
+
 CLAY_WASM_EXPORT("Clay_EndLayout")
 Clay_RenderCommandArray Clay_EndLayout(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
     Clay__CloseElement();
-    if (Clay__debugModeEnabled) {
-        Clay__warningsEnabled = false;
+    if (context->debugModeEnabled) {
+        // The debug view reads the sizes of the declared elements
+        Clay__ResolveMeasureTextBatch();
+        context->warningsEnabled = false;
         Clay__RenderDebugView();
-        Clay__warningsEnabled = true;
+        context->warningsEnabled = true;
     }
-    if (Clay__booleanWarnings.maxElementsExceeded) {
-        Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand ) { .boundingBox = { Clay__layoutDimensions.width / 2 - 59 * 4, Clay__layoutDimensions.height / 2, 0, 0 },  .config = { .textElementConfig = &Clay__DebugView_ErrorTextConfig }, .text = CLAY_STRING("Clay Error: Layout elements exceeded Clay__maxElementCount"), .commandType = CLAY_RENDER_COMMAND_TYPE_TEXT });
+    if (context->booleanWarnings.maxElementsExceeded) {
+        Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand ) { .boundingBox = { context->layoutDimensions.width / 2 - 59 * 4, context->layoutDimensions.height / 2, 0, 0 },  .config = { .textElementConfig = &Clay__DebugView_ErrorTextConfig }, .text = CLAY_STRING("Clay Error: Layout elements exceeded Clay__maxElementCount"), .commandType = CLAY_RENDER_COMMAND_TYPE_TEXT });
     } else {
         Clay__CalculateFinalLayout();
+        if (context->renderCommandBatchingEnabled) {
+            Clay__BatchRenderCommands();
+        }
+    }
+    uint32_t frameHash = Clay__HashRenderCommands(&context->renderCommands);
+    context->frameUnchanged = frameHash == context->frameHash;
+    context->frameHash = frameHash;
+    return context->renderCommands;
+}
+
+// Adds a screen region that needs to be redrawn, merging it with any regions it overlaps so that the list stays short
+void Clay__AddDamageRectangle(Clay_BoundingBox boundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_BoundingBoxArray *damageRectangles = &context->damageRectangles;
+    float left = CLAY__MAX(boundingBox.x, 0);
+    float top = CLAY__MAX(boundingBox.y, 0);
+    float right = CLAY__MIN(boundingBox.x + boundingBox.width, context->layoutDimensions.width);
+    float bottom = CLAY__MIN(boundingBox.y + boundingBox.height, context->layoutDimensions.height);
+    if (right <= left || bottom <= top) {
+        return;
+    }
+    for (uint32_t i = 0; i < damageRectangles->length; ++i) {
+        Clay_BoundingBox existing = damageRectangles->internalArray[i];
+        if (left <= existing.x + existing.width && existing.x <= right && top <= existing.y + existing.height && existing.y <= bottom) {
+            // The merged rectangle may now overlap others, so it's added again from scratch
+            damageRectangles->internalArray[i] = damageRectangles->internalArray[--damageRectangles->length];
+            left = CLAY__MIN(left, existing.x);
+            top = CLAY__MIN(top, existing.y);
+            right = CLAY__MAX(right, existing.x + existing.width);
+            bottom = CLAY__MAX(bottom, existing.y + existing.height);
+            Clay__AddDamageRectangle(CLAY__INIT(Clay_BoundingBox) { left, top, right - left, bottom - top });
+            return;
+        }
+    }
+    if (damageRectangles->length == damageRectangles->capacity) {
+        // Out of space, merge with whichever rectangle grows the least
+        uint32_t bestIndex = 0;
+        float bestGrowth = CLAY__MAXFLOAT;
+        for (uint32_t i = 0; i < damageRectangles->length; ++i) {
+            Clay_BoundingBox existing = damageRectangles->internalArray[i];
+            float mergedArea = (CLAY__MAX(right, existing.x + existing.width) - CLAY__MIN(left, existing.x)) * (CLAY__MAX(bottom, existing.y + existing.height) - CLAY__MIN(top, existing.y));
+            float growth = mergedArea - existing.width * existing.height;
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                bestIndex = i;
+            }
+        }
+        Clay_BoundingBox existing = damageRectangles->internalArray[bestIndex];
+        damageRectangles->internalArray[bestIndex] = damageRectangles->internalArray[--damageRectangles->length];
+        left = CLAY__MIN(left, existing.x);
+        top = CLAY__MIN(top, existing.y);
+        right = CLAY__MAX(right, existing.x + existing.width);
+        bottom = CLAY__MAX(bottom, existing.y + existing.height);
+        Clay__AddDamageRectangle(CLAY__INIT(Clay_BoundingBox) { left, top, right - left, bottom - top });
+        return;
+    }
+    Clay_BoundingBoxArray_Add(damageRectangles, CLAY__INIT(Clay_BoundingBox) { left, top, right - left, bottom - top });
+}
+
+Clay__RenderCommandDiffSlot *Clay__GetRenderCommandDiffSlot(uint32_t id, Clay_RenderCommandType commandType) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__RenderCommandDiffSlotArray *slots = &context->renderCommandDiffSlots;
+    uint32_t slotIndex = Clay__RehashWithNumber(id, commandType) % slots->capacity;
+    // There are always at least twice as many slots as previous render commands, so an empty slot will be found
+    while (slots->internalArray[slotIndex].lastIndex != -1 && (slots->internalArray[slotIndex].id != id || slots->internalArray[slotIndex].commandType != commandType)) {
+        slotIndex = (slotIndex + 1) % slots->capacity;
+    }
+    return &slots->internalArray[slotIndex];
+}
+
+// Copies the render commands with the given status into the next section of the diff buffer
+Clay_RenderCommandArray Clay__CollectRenderCommandDiffs(Clay_RenderCommandArray *renderCommands, Clay__RenderCommandDiffStatus status) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommandArray *diffBuffer = &context->renderCommandDiffs;
+    uint32_t startIndex = diffBuffer->length;
+    for (uint32_t i = 0; i < renderCommands->length; ++i) {
+        if ((Clay__RenderCommandDiffStatus)context->renderCommandDiffStatuses.internalArray[i] == status) {
+            Clay_RenderCommandArray_Add(diffBuffer, renderCommands->internalArray[i]);
+        }
+    }
+    return CLAY__INIT(Clay_RenderCommandArray) { .capacity = diffBuffer->length - startIndex, .length = diffBuffer->length - startIndex, .internalArray = &diffBuffer->internalArray[startIndex] };
+}
+
+Clay_RenderCommandDiff Clay__DiffRenderCommands(Clay_RenderCommandArray renderCommands) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__RenderCommandDiffItemArray previousItems = context->renderCommandDiffItems;
+    context->renderCommandDiffItems = context->previousRenderCommandDiffItems;
+    context->renderCommandDiffItems.length = 0;
+    context->previousRenderCommandDiffItems = previousItems;
+    context->renderCommandDiffs.length = 0;
+    context->damageRectangles.length = 0;
+    // Areas that weren't previously part of the layout have to be drawn from scratch
+    if (context->layoutDimensions.width != context->renderCommandDiffLayoutDimensions.width || context->layoutDimensions.height != context->renderCommandDiffLayoutDimensions.height) {
+        Clay__AddDamageRectangle(CLAY__INIT(Clay_BoundingBox) { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height });
+        context->renderCommandDiffLayoutDimensions = context->layoutDimensions;
+    }
+    int32_t *nextIndices = context->renderCommandDiffNextIndices.internalArray;
+
+    // Chain together the previous frame's commands that share an id and type, in order
+    for (uint32_t i = 0; i < context->renderCommandDiffSlots.capacity; ++i) {
+        context->renderCommandDiffSlots.internalArray[i].lastIndex = -1;
+    }
+    for (uint32_t i = 0; i < previousItems.length; ++i) {
+        Clay__RenderCommandDiffItem *previousItem = &previousItems.internalArray[i];
+        Clay__RenderCommandDiffSlot *slot = Clay__GetRenderCommandDiffSlot(previousItem->id, previousItem->commandType);
+        if (slot->lastIndex == -1) {
+            *slot = CLAY__INIT(Clay__RenderCommandDiffSlot) { .id = previousItem->id, .commandType = previousItem->commandType, .nextMatchIndex = (int32_t)i, .lastIndex = (int32_t)i };
+        } else {
+            nextIndices[slot->lastIndex] = (int32_t)i;
+            slot->lastIndex = (int32_t)i;
+        }
+        nextIndices[i] = -1;
+    }
+
+    // Match each command against the first unmatched previous command with the same id and type
+    for (uint32_t i = 0; i < renderCommands.length; ++i) {
+        Clay_RenderCommand *renderCommand = &renderCommands.internalArray[i];
+        Clay__RenderCommandDiffItem *item = Clay__RenderCommandDiffItemArray_Add(&context->renderCommandDiffItems, CLAY__INIT(Clay__RenderCommandDiffItem) {
+            .boundingBox = renderCommand->boundingBox,
+            .id = renderCommand->id,
+            .commandType = renderCommand->commandType,
+            .contentHash = Clay__HashRenderCommandContent(renderCommand),
+        });
+        Clay__RenderCommandDiffStatus status = CLAY__RENDER_COMMAND_DIFF_STATUS_ADDED;
+        Clay__RenderCommandDiffSlot *slot = Clay__GetRenderCommandDiffSlot(item->id, item->commandType);
+        if (slot->lastIndex != -1 && slot->nextMatchIndex != -1) {
+            int32_t matchIndex = slot->nextMatchIndex;
+            Clay__RenderCommandDiffItem *previousItem = &previousItems.internalArray[matchIndex];
+            slot->nextMatchIndex = nextIndices[matchIndex];
+            nextIndices[matchIndex] = -2; // Mark as matched so it won't be reported as removed
+            if (previousItem->contentHash != item->contentHash) {
+                status = CLAY__RENDER_COMMAND_DIFF_STATUS_CHANGED;
+            } else if (previousItem->boundingBox.x != item->boundingBox.x || previousItem->boundingBox.y != item->boundingBox.y || previousItem->boundingBox.width != item->boundingBox.width || previousItem->boundingBox.height != item->boundingBox.height) {
+                status = CLAY__RENDER_COMMAND_DIFF_STATUS_MOVED;
+            } else {
+                status = CLAY__RENDER_COMMAND_DIFF_STATUS_UNCHANGED;
+            }
+            if (status != CLAY__RENDER_COMMAND_DIFF_STATUS_UNCHANGED) {
+                Clay__AddDamageRectangle(previousItem->boundingBox);
+            }
+        }
+        if (status != CLAY__RENDER_COMMAND_DIFF_STATUS_UNCHANGED) {
+            Clay__AddDamageRectangle(item->boundingBox);
+        }
+        context->renderCommandDiffStatuses.internalArray[i] = status;
+    }
+
+    Clay_RenderCommandDiff diff = { .renderCommands = renderCommands };
+    diff.added = Clay__CollectRenderCommandDiffs(&renderCommands, CLAY__RENDER_COMMAND_DIFF_STATUS_ADDED);
+    diff.moved = Clay__CollectRenderCommandDiffs(&renderCommands, CLAY__RENDER_COMMAND_DIFF_STATUS_MOVED);
+    diff.changed = Clay__CollectRenderCommandDiffs(&renderCommands, CLAY__RENDER_COMMAND_DIFF_STATUS_CHANGED);
+    uint32_t removedStartIndex = context->renderCommandDiffs.length;
+    for (uint32_t i = 0; i < previousItems.length; ++i) {
+        if (nextIndices[i] != -2) {
+            Clay__RenderCommandDiffItem *previousItem = &previousItems.internalArray[i];
+            Clay_RenderCommandArray_Add(&context->renderCommandDiffs, CLAY__INIT(Clay_RenderCommand) { .boundingBox = previousItem->boundingBox, .id = previousItem->id, .commandType = previousItem->commandType });
+            Clay__AddDamageRectangle(previousItem->boundingBox);
+        }
+    }
+    diff.removed = CLAY__INIT(Clay_RenderCommandArray) { .capacity = context->renderCommandDiffs.length - removedStartIndex, .length = context->renderCommandDiffs.length - removedStartIndex, .internalArray = &context->renderCommandDiffs.internalArray[removedStartIndex] };
+    diff.damageRectangles = context->damageRectangles;
+    return diff;
+}
+
+CLAY_WASM_EXPORT("Clay_EndLayoutDiff")
+Clay_RenderCommandDiff Clay_EndLayoutDiff(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+    if (!context->renderCommandDiffItems.internalArray && !Clay__AllocateOptionalFeatureMemory(context, Clay__InitializeRenderCommandDiffMemory, CLAY_STRING("Clay ran out of arena capacity while allocating memory for Clay_EndLayoutDiff. Try adding Clay_OptionalFeatureMemorySize() to the capacity of the arena passed to Clay_Initialize()"))) {
+        // Without the previous frame to compare against, everything is reported as added and the whole layout as damaged
+        context->damageRectangles.length = 0;
+        Clay__AddDamageRectangle(CLAY__INIT(Clay_BoundingBox) { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height });
+        return CLAY__INIT(Clay_RenderCommandDiff) { .renderCommands = renderCommands, .added = renderCommands, .damageRectangles = context->damageRectangles };
+    }
+    return Clay__DiffRenderCommands(renderCommands);
+}
+
+// Longer text is truncated so that the size of a packed command fits in 16 bits
+#define CLAY__PACKED_TEXT_MAX_LENGTH (UINT16_MAX * 8 - sizeof(Clay_PackedRenderCommand) - sizeof(Clay_PackedText))
+
+uint32_t Clay__PackColor(Clay_Color color) {
+    uint32_t r = (uint32_t)(CLAY__MIN(CLAY__MAX(color.r, 0), 255) + 0.5f);
+    uint32_t g = (uint32_t)(CLAY__MIN(CLAY__MAX(color.g, 0), 255) + 0.5f);
+    uint32_t b = (uint32_t)(CLAY__MIN(CLAY__MAX(color.b, 0), 255) + 0.5f);
+    uint32_t a = (uint32_t)(CLAY__MIN(CLAY__MAX(color.a, 0), 255) + 0.5f);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+bool Clay__CornerRadiusIsZero(Clay_CornerRadius *cornerRadius) {
+    return cornerRadius->topLeft == 0 && cornerRadius->topRight == 0 && cornerRadius->bottomLeft == 0 && cornerRadius->bottomRight == 0;
+}
+
+// Returns the size in bytes of the render command once packed, and its flags
+uint32_t Clay__PackedRenderCommandSize(Clay_RenderCommand *renderCommand, uint8_t *flags) {
+    uint32_t size = sizeof(Clay_PackedRenderCommand);
+    *flags = 0;
+    switch (renderCommand->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_NONE: return 0;
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            size += sizeof(Clay_PackedRectangle);
+            if (!Clay__CornerRadiusIsZero(&renderCommand->config.rectangleElementConfig->cornerRadius)) {
+                *flags = CLAY_PACKED_RENDER_COMMAND_FLAG_CORNER_RADIUS;
+                size += sizeof(Clay_CornerRadius);
+            }
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            size += sizeof(Clay_PackedBorder);
+            if (!Clay__CornerRadiusIsZero(&renderCommand->config.borderElementConfig->cornerRadius)) {
+                *flags = CLAY_PACKED_RENDER_COMMAND_FLAG_CORNER_RADIUS;
+                size += sizeof(Clay_CornerRadius);
+            }
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: size += sizeof(Clay_PackedText) + (uint32_t)CLAY__MIN(renderCommand->text.length, CLAY__PACKED_TEXT_MAX_LENGTH); break;
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: size += sizeof(Clay_PackedImage); break;
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: size += sizeof(Clay_PackedCustom); break;
+        default: break;
+    }
+    return (size + 7) & ~7u;
+}
+
+CLAY_WASM_EXPORT("Clay_PackRenderCommands")
+uint32_t Clay_PackRenderCommands(Clay_RenderCommandArray renderCommands, void *buffer, uint32_t bufferSize) {
+    uint32_t streamSize = 0;
+    uint8_t flags;
+    for (uint32_t i = 0; i < renderCommands.length; ++i) {
+        streamSize += Clay__PackedRenderCommandSize(&renderCommands.internalArray[i], &flags);
+    }
+    if (buffer == CLAY__NULL || bufferSize < streamSize) {
+        return streamSize;
+    }
+    uint8_t *output = (uint8_t *)buffer;
+    for (uint32_t i = 0; i < renderCommands.length; ++i) {
+        Clay_RenderCommand *renderCommand = &renderCommands.internalArray[i];
+        uint32_t size = Clay__PackedRenderCommandSize(renderCommand, &flags);
+        if (size == 0) {
+            continue;
+        }
+        *(Clay_PackedRenderCommand *)output = CLAY__INIT(Clay_PackedRenderCommand) {
+            .commandType = (uint8_t)renderCommand->commandType,
+            .flags = flags,
+            .size = (uint16_t)(size / 8),
+            .id = renderCommand->id,
+            .boundingBox = renderCommand->boundingBox,
+        };
+        uint8_t *payload = output + sizeof(Clay_PackedRenderCommand);
+        uint8_t *payloadEnd = payload;
+        switch (renderCommand->commandType) {
+            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+                Clay_RectangleElementConfig *config = renderCommand->config.rectangleElementConfig;
+                *(Clay_PackedRectangle *)payload = CLAY__INIT(Clay_PackedRectangle) { Clay__PackColor(config->color) };
+                payloadEnd = payload + sizeof(Clay_PackedRectangle);
+                if (flags & CLAY_PACKED_RENDER_COMMAND_FLAG_CORNER_RADIUS) {
+                    Clay__CopyBytes(payloadEnd, &config->cornerRadius, sizeof(Clay_CornerRadius));
+                    payloadEnd += sizeof(Clay_CornerRadius);
+                }
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+                Clay_BorderElementConfig *config = renderCommand->config.borderElementConfig;
+                *(Clay_PackedBorder *)payload = CLAY__INIT(Clay_PackedBorder) {
+                    .leftColor = Clay__PackColor(config->left.color),
+                    .rightColor = Clay__PackColor(config->right.color),
+                    .topColor = Clay__PackColor(config->top.color),
+                    .bottomColor = Clay__PackColor(config->bottom.color),
+                    .leftWidth = (uint16_t)config->left.width,
+                    .rightWidth = (uint16_t)config->right.width,
+                    .topWidth = (uint16_t)config->top.width,
+                    .bottomWidth = (uint16_t)config->bottom.width,
+                };
+                payloadEnd = payload + sizeof(Clay_PackedBorder);
+                if (flags & CLAY_PACKED_RENDER_COMMAND_FLAG_CORNER_RADIUS) {
+                    Clay__CopyBytes(payloadEnd, &config->cornerRadius, sizeof(Clay_CornerRadius));
+                    payloadEnd += sizeof(Clay_CornerRadius);
+                }
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+                Clay_TextElementConfig *config = renderCommand->config.textElementConfig;
+                uint32_t length = (uint32_t)CLAY__MIN(renderCommand->text.length, CLAY__PACKED_TEXT_MAX_LENGTH);
+                *(Clay_PackedText *)payload = CLAY__INIT(Clay_PackedText) {
+                    .textColor = Clay__PackColor(config->textColor),
+                    .fontId = config->fontId,
+                    .fontSize = config->fontSize,
+                    .letterSpacing = config->letterSpacing,
+                    .lineHeight = config->lineHeight,
+                    .length = length,
+                };
+                payloadEnd = payload + sizeof(Clay_PackedText);
+                Clay__CopyBytes(payloadEnd, renderCommand->text.chars, length);
+                payloadEnd += length;
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+                Clay_ImageElementConfig *config = renderCommand->config.imageElementConfig;
+                *(Clay_PackedImage *)payload = CLAY__INIT(Clay_PackedImage) { config->imageData, config->sourceDimensions };
+                payloadEnd = payload + sizeof(Clay_PackedImage);
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+                *(Clay_PackedCustom *)payload = CLAY__INIT(Clay_PackedCustom) { renderCommand->config.customElementConfig };
+                payloadEnd = payload + sizeof(Clay_PackedCustom);
+                break;
+            }
+            default: break;
+        }
+        // Zero the padding so that identical frames produce identical streams
+        while (payloadEnd < output + size) {
+            *payloadEnd++ = 0;
+        }
+        output += size;
     }
-    return Clay__renderCommands;
+    return streamSize;
 }
 
 CLAY_WASM_EXPORT("Clay_GetElementId")
@@ -3785,7 +6872,8 @@ Clay_ElementId Clay_GetElementIdWithIndex(Clay_String idString, uint32_t index)
 }
 
 bool Clay_Hovered(void) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return false;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
@@ -3793,8 +6881,8 @@ bool Clay_Hovered(void) {
     if (openLayoutElement->id == 0) {
         Clay__GenerateIdForAnonymousElement(openLayoutElement);
     }
-    for (uint32_t i = 0; i < Clay__pointerOverIds.length; ++i) {
-        if (Clay__ElementIdArray_Get(&Clay__pointerOverIds, i)->id == openLayoutElement->id) {
+    for (uint32_t i = 0; i < context->pointerOverIds.length; ++i) {
+        if (Clay__ElementIdArray_Get(&context->pointerOverIds, i)->id == openLayoutElement->id) {
             return true;
         }
     }
@@ -3802,7 +6890,8 @@ bool Clay_Hovered(void) {
 }
 
 void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData), intptr_t userData) {
-    if (Clay__booleanWarnings.maxElementsExceeded) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
         return;
     }
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
@@ -3816,8 +6905,9 @@ void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId elementId, Clay_Pointer
 
 CLAY_WASM_EXPORT("Clay_PointerOver")
 bool Clay_PointerOver(Clay_ElementId elementId) { // TODO return priority for separating multiple results
-    for (uint32_t i = 0; i < Clay__pointerOverIds.length; ++i) {
-        if (Clay__ElementIdArray_Get(&Clay__pointerOverIds, i)->id == elementId.id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (uint32_t i = 0; i < context->pointerOverIds.length; ++i) {
+        if (Clay__ElementIdArray_Get(&context->pointerOverIds, i)->id == elementId.id) {
             return true;
         }
     }
@@ -3826,49 +6916,188 @@ bool Clay_PointerOver(Clay_ElementId elementId) { // TODO return priority for se
 
 CLAY_WASM_EXPORT("Clay_GetScrollContainerData")
 Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_ElementId id) {
-    for (uint32_t i = 0; i < Clay__scrollContainerDatas.length; ++i) {
-        Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&Clay__scrollContainerDatas, i);
-        if (scrollContainerData->elementId == id.id) {
-            return CLAY__INIT(Clay_ScrollContainerData) {
-                .scrollPosition = &scrollContainerData->scrollPosition,
-                .scrollContainerDimensions = { scrollContainerData->boundingBox.width, scrollContainerData->boundingBox.height },
-                .contentDimensions = scrollContainerData->contentSize,
-                .config = *Clay__FindElementConfigWithType(scrollContainerData->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig,
-                .found = true
-            };
-        }
+    Clay__ScrollContainerDataInternal *scrollContainerData = Clay__GetScrollContainerData(id.id);
+    if (scrollContainerData) {
+        return CLAY__INIT(Clay_ScrollContainerData) {
+            .scrollPosition = &scrollContainerData->scrollPosition,
+            .scrollContainerDimensions = { scrollContainerData->boundingBox.width, scrollContainerData->boundingBox.height },
+            .contentDimensions = scrollContainerData->contentSize,
+            .config = *Clay__FindElementConfigWithType(scrollContainerData->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_SCROLL_CONTAINER).scrollElementConfig,
+            .virtualItemsStartIndex = scrollContainerData->virtualItemsStartIndex,
+            .virtualItemsEndIndex = scrollContainerData->virtualItemsEndIndex,
+            .found = true
+        };
     }
     return CLAY__INIT(Clay_ScrollContainerData) {0};
 }
 
 CLAY_WASM_EXPORT("Clay_SetDebugModeEnabled")
 void Clay_SetDebugModeEnabled(bool enabled) {
-    Clay__debugModeEnabled = enabled;
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->debugModeEnabled = enabled;
 }
 
 CLAY_WASM_EXPORT("Clay_IsDebugModeEnabled")
 bool Clay_IsDebugModeEnabled(void) {
-    return Clay__debugModeEnabled;
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->debugModeEnabled;
 }
 
 CLAY_WASM_EXPORT("Clay_SetCullingEnabled")
 void Clay_SetCullingEnabled(bool enabled) {
-    Clay__disableCulling = !enabled;
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->disableCulling = !enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_SetIncrementalLayoutEnabled")
+void Clay_SetIncrementalLayoutEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (enabled && !context->layoutCaches.internalArray) {
+        if (!Clay__AllocateOptionalFeatureMemory(context, Clay__InitializeLayoutCacheMemory, CLAY_STRING("Clay ran out of arena capacity while allocating memory for incremental layout. Try adding Clay_OptionalFeatureMemorySize() to the capacity of the arena passed to Clay_Initialize()"))) {
+            return;
+        }
+        for (uint32_t i = 0; i < context->layoutCaches.capacity; ++i) {
+            context->layoutCaches.internalArray[i] = CLAY__INIT(Clay__LayoutCacheData) {0};
+        }
+    }
+    context->incrementalLayoutEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_SetTextContentHashingEnabled")
+void Clay_SetTextContentHashingEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->textContentHashingEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_SetWrappedTextCachingEnabled")
+void Clay_SetWrappedTextCachingEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (enabled && !context->wrappedLinesCacheEntries.internalArray) {
+        if (!Clay__AllocateOptionalFeatureMemory(context, Clay__InitializeWrappedTextCacheMemory, CLAY_STRING("Clay ran out of arena capacity while allocating memory for wrapped text caching. Try adding Clay_OptionalFeatureMemorySize() to the capacity of the arena passed to Clay_Initialize()"))) {
+            return;
+        }
+        for (uint32_t i = 0; i < context->wrappedLinesCacheEntries.capacity; ++i) {
+            context->wrappedLinesCacheEntries.internalArray[i] = CLAY__INIT(Clay__WrappedLinesCacheEntry) {0};
+        }
+    }
+    context->wrappedTextCachingEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_SetRenderCommandBatchingEnabled")
+void Clay_SetRenderCommandBatchingEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (enabled && !context->renderCommandBatchItems.internalArray && !Clay__AllocateOptionalFeatureMemory(context, Clay__InitializeRenderCommandBatchMemory, CLAY_STRING("Clay ran out of arena capacity while allocating memory for render command batching. Try adding Clay_OptionalFeatureMemorySize() to the capacity of the arena passed to Clay_Initialize()"))) {
+        return;
+    }
+    context->renderCommandBatchingEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_IsFrameUnchanged")
+bool Clay_IsFrameUnchanged(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->frameUnchanged;
+}
+
+CLAY_WASM_EXPORT("Clay_IsScrollAnimationActive")
+bool Clay_IsScrollAnimationActive(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context->scrollAnimationActive;
 }
 
 CLAY_WASM_EXPORT("Clay_SetExternalScrollHandlingEnabled")
 void Clay_SetExternalScrollHandlingEnabled(bool enabled) {
-    Clay__externalScrollHandlingEnabled = enabled;
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->externalScrollHandlingEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxElementCount")
+uint32_t Clay_GetMaxElementCount(void) {
+    return Clay__defaultMaxElementCount;
 }
 
 CLAY_WASM_EXPORT("Clay_SetMaxElementCount")
 void Clay_SetMaxElementCount(uint32_t maxElementCount) {
-    Clay__maxElementCount = maxElementCount;
+    Clay__defaultMaxElementCount = maxElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxMeasureTextCacheWordCount")
+uint32_t Clay_GetMaxMeasureTextCacheWordCount(void) {
+    return Clay__defaultMaxMeasureTextCacheWordCount;
 }
 
 CLAY_WASM_EXPORT("Clay_SetMaxMeasureTextCacheWordCount")
 void Clay_SetMaxMeasureTextCacheWordCount(uint32_t maxMeasureTextCacheWordCount) {
-    Clay__maxMeasureTextCacheWordCount = maxMeasureTextCacheWordCount;
+    Clay__defaultMaxMeasureTextCacheWordCount = maxMeasureTextCacheWordCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxScrollContainerCount")
+uint32_t Clay_GetMaxScrollContainerCount(void) {
+    return Clay__defaultMaxScrollContainerCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxScrollContainerCount")
+void Clay_SetMaxScrollContainerCount(uint32_t maxScrollContainerCount) {
+    Clay__defaultMaxScrollContainerCount = maxScrollContainerCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxTextElementCount")
+uint32_t Clay_GetMaxTextElementCount(void) {
+    return Clay__defaultMaxTextElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxTextElementCount")
+void Clay_SetMaxTextElementCount(uint32_t maxTextElementCount) {
+    Clay__defaultMaxTextElementCount = maxTextElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxImageElementCount")
+uint32_t Clay_GetMaxImageElementCount(void) {
+    return Clay__defaultMaxImageElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxImageElementCount")
+void Clay_SetMaxImageElementCount(uint32_t maxImageElementCount) {
+    Clay__defaultMaxImageElementCount = maxImageElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxFloatingElementCount")
+uint32_t Clay_GetMaxFloatingElementCount(void) {
+    return Clay__defaultMaxFloatingElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxFloatingElementCount")
+void Clay_SetMaxFloatingElementCount(uint32_t maxFloatingElementCount) {
+    Clay__defaultMaxFloatingElementCount = maxFloatingElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxBorderElementCount")
+uint32_t Clay_GetMaxBorderElementCount(void) {
+    return Clay__defaultMaxBorderElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxBorderElementCount")
+void Clay_SetMaxBorderElementCount(uint32_t maxBorderElementCount) {
+    Clay__defaultMaxBorderElementCount = maxBorderElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxCustomElementCount")
+uint32_t Clay_GetMaxCustomElementCount(void) {
+    return Clay__defaultMaxCustomElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxCustomElementCount")
+void Clay_SetMaxCustomElementCount(uint32_t maxCustomElementCount) {
+    Clay__defaultMaxCustomElementCount = maxCustomElementCount;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMaxPersistedConfigCount")
+uint32_t Clay_GetMaxPersistedConfigCount(void) {
+    return Clay__defaultMaxPersistedConfigCount;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxPersistedConfigCount")
+void Clay_SetMaxPersistedConfigCount(uint32_t maxPersistedConfigCount) {
+    Clay__defaultMaxPersistedConfigCount = maxPersistedConfigCount;
 }
 
 #endif // CLAY_IMPLEMENTATION
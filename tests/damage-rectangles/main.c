@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Tests for the damage rectangles reported by Clay_EndLayoutDiff
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+// A fixed box followed by a box that is pushed right by offset
+Clay_RenderCommandDiff LayoutTestFrame(float offset) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Row"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIT(), CLAY_SIZING_FIT() } })) {
+        CLAY(CLAY_ID("Fixed"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_FIXED(50) } }), CLAY_RECTANGLE({ .color = {255, 0, 0, 255} })) {}
+        CLAY(CLAY_ID("Spacer"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(offset) } })) {}
+        CLAY(CLAY_ID("Moving"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_FIXED(50) } }), CLAY_RECTANGLE({ .color = {0, 0, 255, 255} })) {}
+    }
+    return Clay_EndLayoutDiff();
+}
+
+bool ContainsDamageRectangle(Clay_RenderCommandDiff diff, Clay_BoundingBox expected) {
+    for (uint32_t i = 0; i < diff.damageRectangles.length; ++i) {
+        Clay_BoundingBox *damage = &diff.damageRectangles.internalArray[i];
+        if (damage->x == expected.x && damage->y == expected.y && damage->width == expected.width && damage->height == expected.height) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int ExpectDamage(const char *name, Clay_RenderCommandDiff diff, Clay_BoundingBox *expected, uint32_t expectedCount) {
+    bool matches = diff.damageRectangles.length == expectedCount;
+    for (uint32_t i = 0; i < expectedCount && matches; ++i) {
+        matches = ContainsDamageRectangle(diff, expected[i]);
+    }
+    if (!matches) {
+        printf("%s: expected %u damage rectangles, got\n", name, expectedCount);
+        for (uint32_t i = 0; i < diff.damageRectangles.length; ++i) {
+            Clay_BoundingBox *damage = &diff.damageRectangles.internalArray[i];
+            printf("  { %g, %g, %g, %g }\n", damage->x, damage->y, damage->width, damage->height);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+// The first frame, and any frame where the layout dimensions change, damages the whole layout
+int TestNewLayoutDamagesEverything(void) {
+    int failures = ExpectDamage("TestNewLayoutDamagesEverything (first frame)", LayoutTestFrame(0), &(Clay_BoundingBox) {0, 0, 1024, 768}, 1);
+    failures += ExpectDamage("TestNewLayoutDamagesEverything (unchanged)", LayoutTestFrame(0), NULL, 0);
+    Clay_SetLayoutDimensions((Clay_Dimensions) {800, 600});
+    failures += ExpectDamage("TestNewLayoutDamagesEverything (resized)", LayoutTestFrame(0), &(Clay_BoundingBox) {0, 0, 800, 600}, 1);
+    Clay_SetLayoutDimensions((Clay_Dimensions) {1024, 768});
+    LayoutTestFrame(0);
+    return failures;
+}
+
+// A moved element damages where it was and where it is now, merged into one rectangle when the two overlap
+int TestMovedElementDamage(void) {
+    LayoutTestFrame(0);
+    int failures = ExpectDamage("TestMovedElementDamage (overlapping)", LayoutTestFrame(20), &(Clay_BoundingBox) {50, 0, 70, 50}, 1);
+    Clay_BoundingBox apart[] = { {70, 0, 50, 50}, {400, 0, 50, 50} };
+    failures += ExpectDamage("TestMovedElementDamage (apart)", LayoutTestFrame(350), apart, 2);
+    failures += ExpectDamage("TestMovedElementDamage (unchanged)", LayoutTestFrame(350), NULL, 0);
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize() + Clay_OptionalFeatureMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = 0;
+    failures += TestNewLayoutDamagesEverything();
+    failures += TestMovedElementDamage();
+    if (failures > 0 || errorCount > 0) {
+        printf("Damage rectangle tests failed\n");
+        return 1;
+    }
+    printf("Damage rectangle tests passed\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Tests for Clay_IsFrameUnchanged
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+typedef struct {
+    Clay_Color color;
+    float width;
+    Clay_String text;
+} TestFrameState;
+
+bool LayoutTestFrame(TestFrameState *state) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Box"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(state->width), CLAY_SIZING_FIXED(50) } }), CLAY_RECTANGLE({ .color = state->color })) {
+        CLAY_TEXT(state->text, CLAY_TEXT_CONFIG({ .textColor = {255, 255, 255, 255}, .fontSize = 10 }));
+    }
+    Clay_EndLayout();
+    return Clay_IsFrameUnchanged();
+}
+
+// Lays out a frame that differs from the one before it, which must be reported as changed, then lays it out again
+int ExpectChangedThenUnchanged(const char *name, TestFrameState *state) {
+    int failures = 0;
+    if (LayoutTestFrame(state)) {
+        printf("%s: expected the frame to be reported as changed\n", name);
+        failures++;
+    }
+    if (!LayoutTestFrame(state)) {
+        printf("%s: expected the repeated frame to be reported as unchanged\n", name);
+        failures++;
+    }
+    return failures;
+}
+
+int TestIsFrameUnchanged(void) {
+    TestFrameState state = { .color = {255, 0, 0, 255}, .width = 100, .text = CLAY_STRING("some text") };
+    int failures = ExpectChangedThenUnchanged("TestIsFrameUnchanged (first frame)", &state);
+    state.color = (Clay_Color) {0, 255, 0, 255};
+    failures += ExpectChangedThenUnchanged("TestIsFrameUnchanged (color)", &state);
+    state.width = 120;
+    failures += ExpectChangedThenUnchanged("TestIsFrameUnchanged (size)", &state);
+    // The same length, so only the content of the text differs
+    state.text = CLAY_STRING("SOME TEXT");
+    failures += ExpectChangedThenUnchanged("TestIsFrameUnchanged (text)", &state);
+    Clay_SetLayoutDimensions((Clay_Dimensions) {800, 600});
+    failures += ExpectChangedThenUnchanged("TestIsFrameUnchanged (layout dimensions)", &state);
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = TestIsFrameUnchanged();
+    if (failures > 0 || errorCount > 0) {
+        printf("Frame unchanged tests failed\n");
+        return 1;
+    }
+    printf("Frame unchanged tests passed\n");
+    return 0;
+}
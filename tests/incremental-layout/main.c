@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Regression tests for incremental layout. The arena is filled with a non zero pattern so that any read of memory clay
+// hasn't initialized shows up as a crash or a wrong result rather than silently reading zeroes.
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+// Lays out a root with no children several times, so that the second frame onwards takes the cached layout path
+int TestEmptyFrame(void) {
+    for (int frame = 0; frame < 3; ++frame) {
+        Clay_BeginLayout();
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+        if (renderCommands.length != 0) {
+            printf("TestEmptyFrame: expected no render commands on frame %d, got %d\n", frame, renderCommands.length);
+            return 1;
+        }
+    }
+    for (int frame = 0; frame < 3; ++frame) {
+        Clay_BeginLayout();
+        CLAY(CLAY_ID("Empty"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() } }), CLAY_RECTANGLE({ .color = {1, 2, 3, 255} })) {}
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+        if (renderCommands.length != 1 || renderCommands.internalArray[0].boundingBox.width != 1024 || renderCommands.internalArray[0].boundingBox.height != 768) {
+            printf("TestEmptyFrame: expected one full screen rectangle on frame %d\n", frame);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// The declarations a test frame is built from. Each test changes one of them between frames.
+typedef struct {
+    Clay_Dimensions layoutDimensions;
+    float sidebarWidth;
+    float leafWidth;
+    Clay_String headline;
+} TestFrameState;
+
+Clay_TextElementConfig *TestTextConfig(void) {
+    return CLAY_TEXT_CONFIG({ .textColor = {255, 255, 255, 255}, .fontSize = 10 });
+}
+
+void DeclareTestFrame(TestFrameState *state) {
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() }, .padding = {8, 8}, .childGap = 8 }), CLAY_RECTANGLE({ .color = {10, 10, 10, 255} })) {
+        CLAY(CLAY_ID("Sidebar"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(state->sidebarWidth), CLAY_SIZING_GROW() }, .padding = {4, 4}, .childGap = 4, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_RECTANGLE({ .color = {20, 20, 20, 255} })) {
+            CLAY(CLAY_ID("Headline"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW() } }), CLAY_RECTANGLE({ .color = {30, 30, 30, 255} })) {
+                CLAY_TEXT(state->headline, TestTextConfig());
+            }
+            CLAY(CLAY_ID("Leaf"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(state->leafWidth), CLAY_SIZING_FIXED(20) } }), CLAY_RECTANGLE({ .color = {40, 40, 40, 255} })) {}
+            CLAY(CLAY_ID("Footer"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() } }), CLAY_RECTANGLE({ .color = {50, 50, 50, 255} })) {
+                CLAY_TEXT(CLAY_STRING("a footer that wraps when the sidebar is narrow"), TestTextConfig());
+            }
+        }
+        CLAY(CLAY_ID("Content"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() }, .childGap = 4, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_RECTANGLE({ .color = {60, 60, 60, 255} })) {
+            for (int i = 0; i < 4; ++i) {
+                CLAY(CLAY_IDI("Card", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW() }, .padding = {2, 2}, .childGap = 2 }), CLAY_RECTANGLE({ .color = {70, 70, 70, 255} })) {
+                    CLAY_TEXT(CLAY_STRING("cards stay the same in every frame"), TestTextConfig());
+                    CLAY(CLAY_IDI("CardIcon", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(16), CLAY_SIZING_FIXED(16) } }), CLAY_RECTANGLE({ .color = {80, 80, 80, 255} })) {}
+                }
+            }
+        }
+    }
+}
+
+Clay_RenderCommandArray LayoutTestFrame(Clay_Context *context, TestFrameState *state) {
+    Clay_SetCurrentContext(context);
+    Clay_SetLayoutDimensions(state->layoutDimensions);
+    Clay_BeginLayout();
+    DeclareTestFrame(state);
+    return Clay_EndLayout();
+}
+
+int CompareRenderCommands(const char *name, int frame, Clay_RenderCommandArray expected, Clay_RenderCommandArray actual) {
+    if (expected.length != actual.length) {
+        printf("%s: expected %d render commands on frame %d, got %d\n", name, expected.length, frame, actual.length);
+        return 1;
+    }
+    for (uint32_t i = 0; i < expected.length; ++i) {
+        Clay_RenderCommand *a = &expected.internalArray[i], *b = &actual.internalArray[i];
+        bool textMatches = a->text.length == b->text.length && (a->text.length == 0 || memcmp(a->text.chars, b->text.chars, a->text.length) == 0);
+        if (a->commandType != b->commandType || a->id != b->id || !textMatches || memcmp(&a->boundingBox, &b->boundingBox, sizeof(Clay_BoundingBox)) != 0) {
+            printf("%s: render command %d on frame %d differs, expected { %g, %g, %g, %g } \"%.*s\", got { %g, %g, %g, %g } \"%.*s\"\n", name, i, frame,
+                a->boundingBox.x, a->boundingBox.y, a->boundingBox.width, a->boundingBox.height, (int)a->text.length, a->text.chars,
+                b->boundingBox.x, b->boundingBox.y, b->boundingBox.width, b->boundingBox.height, (int)b->text.length, b->text.chars);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+Clay_Context *CreateTestContext(bool incrementalLayoutEnabled) {
+    Clay_Context *previousContext = Clay_GetCurrentContext();
+    uint32_t totalMemorySize = Clay_MinMemorySize() + Clay_OptionalFeatureMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Context *context = Clay_CreateContext(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetCurrentContext(context);
+    Clay_SetIncrementalLayoutEnabled(incrementalLayoutEnabled);
+    Clay_SetCurrentContext(previousContext);
+    return context;
+}
+
+// Lays out the same frames with and without incremental layout. updateState is called before every frame after the
+// first, and the frame before it is laid out again unchanged, so that both the changed frame and the one restoring from
+// it are compared.
+int CompareWithFullLayout(const char *name, void (*updateState)(TestFrameState *state, int frame)) {
+    Clay_Context *previousContext = Clay_GetCurrentContext();
+    Clay_Context *incrementalContext = CreateTestContext(true);
+    Clay_Context *fullContext = CreateTestContext(false);
+    TestFrameState state = { .layoutDimensions = {1024, 768}, .sidebarWidth = 200, .leafWidth = 50, .headline = CLAY_STRING("the headline") };
+    int failures = 0;
+    for (int frame = 0; frame < 12 && failures == 0; ++frame) {
+        if (frame > 0 && frame % 2 == 0) {
+            updateState(&state, frame / 2);
+        }
+        Clay_RenderCommandArray expected = LayoutTestFrame(fullContext, &state);
+        Clay_RenderCommandArray actual = LayoutTestFrame(incrementalContext, &state);
+        failures += CompareRenderCommands(name, frame, expected, actual);
+    }
+    Clay_SetCurrentContext(previousContext);
+    free(incrementalContext->internalArena.memory);
+    free(fullContext->internalArena.memory);
+    return failures;
+}
+
+// A leaf changes size without anything around it being declared differently
+void MutateLeaf(TestFrameState *state, int step) {
+    state->leafWidth = step % 2 == 0 ? 50 : 180 + (float)step;
+}
+
+// Elements declared the same way are given a different size by their parents
+void ResizeParents(TestFrameState *state, int step) {
+    state->sidebarWidth = step % 2 == 0 ? 200 : 90 + (float)step * 10;
+    state->layoutDimensions = step % 3 == 0 ? (Clay_Dimensions) {1024, 768} : (Clay_Dimensions) {640 + (float)step * 20, 480};
+}
+
+// The headline is swapped for text of the same length or a different one. The two long headlines have the same length
+// but wrap at different words.
+void SwapText(TestFrameState *state, int step) {
+    Clay_String headlines[] = { CLAY_STRING("the headline"), CLAY_STRING("THE HEADLINE"), CLAY_STRING("the headline that is long enough to wrap"), CLAY_STRING("headlines of one length wrap differently"), CLAY_STRING("a new headline"), CLAY_STRING("x") };
+    state->headline = headlines[step % 6];
+}
+
+int TestIncrementalMatchesFullLayout(void) {
+    int failures = 0;
+    failures += CompareWithFullLayout("TestIncrementalMatchesFullLayout (mutate leaf)", MutateLeaf);
+    failures += CompareWithFullLayout("TestIncrementalMatchesFullLayout (resize parents)", ResizeParents);
+    failures += CompareWithFullLayout("TestIncrementalMatchesFullLayout (swap text)", SwapText);
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize() + Clay_OptionalFeatureMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    Clay_SetIncrementalLayoutEnabled(true);
+    int failures = TestEmptyFrame();
+    failures += TestIncrementalMatchesFullLayout();
+    if (failures > 0 || errorCount > 0) {
+        printf("Incremental layout tests failed\n");
+        return 1;
+    }
+    printf("Incremental layout tests passed\n");
+    return 0;
+}
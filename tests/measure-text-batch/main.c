@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Tests for Clay_SetMeasureTextBatchFunction. The same frames are laid out in two contexts, one measuring each word as
+// it is declared and one measuring them in batches, and must give the same render commands.
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+// Characters have different widths, so that text of the same length can measure differently
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    float width = 0;
+    for (int32_t i = 0; i < text->length; ++i) {
+        width += (float)(1 + (unsigned char)text->chars[i] % 3) * (float)config->fontSize / 2;
+    }
+    if (text->length > 1) {
+        width += (float)config->letterSpacing * (float)(text->length - 1);
+    }
+    return (Clay_Dimensions) { .width = width, .height = config->fontSize };
+}
+
+int batchCallCount = 0;
+uint32_t batchItemCount = 0;
+
+void MeasureTextBatch(Clay_MeasureTextBatchItem *items, uint32_t itemCount, Clay_Dimensions *dimensions) {
+    batchCallCount++;
+    batchItemCount += itemCount;
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        dimensions[i] = MeasureText(&items[i].text, items[i].config);
+    }
+}
+
+// More distinct words than fit in a single batch
+char manyWords[16384];
+
+void DeclareTestFrame(void) {
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() }, .padding = {8, 8}, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+        CLAY(CLAY_ID("Narrow"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(120) }, .childGap = 4, .layoutDirection = CLAY_TOP_TO_BOTTOM })) {
+            CLAY_TEXT(CLAY_STRING("a paragraph that wraps onto several lines, repeating a paragraph word or two"), CLAY_TEXT_CONFIG({ .fontSize = 10 }));
+            CLAY_TEXT(CLAY_STRING("explicit\nnew lines\n\nand spacing"), CLAY_TEXT_CONFIG({ .fontSize = 12, .letterSpacing = 2 }));
+            CLAY_TEXT(CLAY_STRING("the same words at another size"), CLAY_TEXT_CONFIG({ .fontSize = 16 }));
+            CLAY_TEXT(CLAY_STRING("text that isn't wrapped at all"), CLAY_TEXT_CONFIG({ .fontSize = 10, .wrapMode = CLAY_TEXT_WRAP_NONE }));
+        }
+        CLAY_TEXT(((Clay_String) { .length = (int32_t)strlen(manyWords), .chars = manyWords }), CLAY_TEXT_CONFIG({ .fontSize = 8 }));
+    }
+}
+
+Clay_RenderCommandArray LayoutTestFrame(Clay_Context *context, bool batched) {
+    Clay_SetCurrentContext(context);
+    Clay_SetMeasureTextBatchFunction(batched ? MeasureTextBatch : NULL);
+    Clay_BeginLayout();
+    DeclareTestFrame();
+    return Clay_EndLayout();
+}
+
+int CompareRenderCommands(const char *name, Clay_RenderCommandArray expected, Clay_RenderCommandArray actual) {
+    if (expected.length != actual.length) {
+        printf("%s: expected %u render commands, got %u\n", name, expected.length, actual.length);
+        return 1;
+    }
+    for (uint32_t i = 0; i < expected.length; ++i) {
+        Clay_RenderCommand *a = &expected.internalArray[i], *b = &actual.internalArray[i];
+        bool textMatches = a->text.length == b->text.length && (a->text.length == 0 || memcmp(a->text.chars, b->text.chars, a->text.length) == 0);
+        if (a->commandType != b->commandType || a->id != b->id || !textMatches || memcmp(&a->boundingBox, &b->boundingBox, sizeof(Clay_BoundingBox)) != 0) {
+            printf("%s: render command %u differs, expected { %g, %g, %g, %g } \"%.*s\", got { %g, %g, %g, %g } \"%.*s\"\n", name, i,
+                a->boundingBox.x, a->boundingBox.y, a->boundingBox.width, a->boundingBox.height, (int)a->text.length, a->text.chars,
+                b->boundingBox.x, b->boundingBox.y, b->boundingBox.width, b->boundingBox.height, (int)b->text.length, b->text.chars);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+Clay_Context *CreateTestContext(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    return Clay_CreateContext(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+}
+
+int TestBatchMatchesMeasureText(void) {
+    int32_t length = 0;
+    for (int i = 0; i < 1500; ++i) {
+        length += snprintf(&manyWords[length], sizeof(manyWords) - (size_t)length, i == 0 ? "word%d" : " word%d", i);
+    }
+    Clay_Context *singleContext = CreateTestContext();
+    Clay_Context *batchedContext = CreateTestContext();
+    int failures = 0;
+    for (int frame = 0; frame < 2; ++frame) {
+        int previousBatchCallCount = batchCallCount;
+        Clay_RenderCommandArray expected = LayoutTestFrame(singleContext, false);
+        Clay_RenderCommandArray actual = LayoutTestFrame(batchedContext, true);
+        failures += CompareRenderCommands(frame == 0 ? "TestBatchMatchesMeasureText (first frame)" : "TestBatchMatchesMeasureText (cached)", expected, actual);
+        // Every word is new on the first frame, and needs more than one batch. After that they are all cached.
+        if (frame == 0 && (batchCallCount < 2 || batchItemCount < 1500)) {
+            printf("TestBatchMatchesMeasureText: expected at least 1500 words in more than one batch, got %u in %d\n", batchItemCount, batchCallCount);
+            failures++;
+        } else if (frame == 1 && batchCallCount != previousBatchCallCount) {
+            printf("TestBatchMatchesMeasureText: expected no batches once every word was cached, got %d\n", batchCallCount - previousBatchCallCount);
+            failures++;
+        }
+    }
+    Clay_SetMeasureTextBatchFunction(NULL);
+    free(singleContext->internalArena.memory);
+    free(batchedContext->internalArena.memory);
+    return failures;
+}
+
+int main(void) {
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = TestBatchMatchesMeasureText();
+    if (failures > 0 || errorCount > 0) {
+        printf("Measure text batch tests failed\n");
+        return 1;
+    }
+    printf("Measure text batch tests passed\n");
+    return 0;
+}
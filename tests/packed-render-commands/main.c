@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Tests for Clay_PackRenderCommands. Each frame is packed, then read back and compared with the render commands it was
+// packed from.
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+int imageData = 1;
+int customData = 2;
+
+// One of every kind of render command, with and without corner radii
+Clay_RenderCommandArray LayoutTestFrame(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() }, .padding = {8, 8}, .childGap = 8, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_RECTANGLE({ .color = {10, 20, 30, 255} })) {
+        CLAY(CLAY_ID("Rounded"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(100), CLAY_SIZING_FIXED(40) } }), CLAY_RECTANGLE({ .color = {40, 50, 60, 128}, .cornerRadius = {1, 2, 3, 4} })) {}
+        CLAY(CLAY_ID("Bordered"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(100), CLAY_SIZING_FIXED(40) } }), CLAY_BORDER({ .left = {1, {255, 0, 0, 255}}, .right = {2, {0, 255, 0, 255}}, .top = {3, {0, 0, 255, 255}}, .bottom = {4, {255, 255, 0, 255}}, .cornerRadius = {5, 5, 5, 5} })) {}
+        CLAY(CLAY_ID("Square"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(100), CLAY_SIZING_FIXED(40) } }), CLAY_BORDER_OUTSIDE({ 2, {70, 80, 90, 255} })) {}
+        CLAY(CLAY_ID("Scroll"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(200), CLAY_SIZING_FIXED(30) } }), CLAY_SCROLL({ .vertical = true })) {
+            CLAY_TEXT(CLAY_STRING("text of an odd length"), CLAY_TEXT_CONFIG({ .textColor = {200, 210, 220, 230}, .fontId = 3, .fontSize = 10, .letterSpacing = 1, .lineHeight = 12 }));
+        }
+        CLAY(CLAY_ID("Image"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(32), CLAY_SIZING_FIXED(32) } }), CLAY_IMAGE({ .imageData = &imageData, .sourceDimensions = {64, 64} })) {}
+        CLAY(CLAY_ID("Custom"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(32), CLAY_SIZING_FIXED(32) } }), CLAY_CUSTOM_ELEMENT({ .customData = &customData })) {}
+    }
+    return Clay_EndLayout();
+}
+
+bool ColorMatches(uint32_t packed, Clay_Color color) {
+    return (packed & 0xff) == (uint32_t)color.r && ((packed >> 8) & 0xff) == (uint32_t)color.g && ((packed >> 16) & 0xff) == (uint32_t)color.b && (packed >> 24) == (uint32_t)color.a;
+}
+
+bool CornerRadiusMatches(Clay_PackedRenderCommand *command, void *payloadEnd, Clay_CornerRadius cornerRadius) {
+    bool isZero = cornerRadius.topLeft == 0 && cornerRadius.topRight == 0 && cornerRadius.bottomLeft == 0 && cornerRadius.bottomRight == 0;
+    if (!(command->flags & CLAY_PACKED_RENDER_COMMAND_FLAG_CORNER_RADIUS)) {
+        return isZero;
+    }
+    Clay_CornerRadius packed;
+    memcpy(&packed, payloadEnd, sizeof(Clay_CornerRadius));
+    return !isZero && memcmp(&packed, &cornerRadius, sizeof(Clay_CornerRadius)) == 0;
+}
+
+// Compares one packed command, and the payload following it, with the render command it was packed from
+bool PackedCommandMatches(Clay_PackedRenderCommand *command, Clay_RenderCommand *renderCommand) {
+    if (command->commandType != renderCommand->commandType || command->id != renderCommand->id || memcmp(&command->boundingBox, &renderCommand->boundingBox, sizeof(Clay_BoundingBox)) != 0) {
+        return false;
+    }
+    void *payload = command + 1;
+    switch (renderCommand->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            Clay_RectangleElementConfig *config = renderCommand->config.rectangleElementConfig;
+            Clay_PackedRectangle *rectangle = (Clay_PackedRectangle *)payload;
+            return ColorMatches(rectangle->color, config->color) && CornerRadiusMatches(command, rectangle + 1, config->cornerRadius);
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_BorderElementConfig *config = renderCommand->config.borderElementConfig;
+            Clay_PackedBorder *border = (Clay_PackedBorder *)payload;
+            return ColorMatches(border->leftColor, config->left.color) && ColorMatches(border->rightColor, config->right.color)
+                && ColorMatches(border->topColor, config->top.color) && ColorMatches(border->bottomColor, config->bottom.color)
+                && border->leftWidth == config->left.width && border->rightWidth == config->right.width
+                && border->topWidth == config->top.width && border->bottomWidth == config->bottom.width
+                && CornerRadiusMatches(command, border + 1, config->cornerRadius);
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            Clay_TextElementConfig *config = renderCommand->config.textElementConfig;
+            Clay_PackedText *text = (Clay_PackedText *)payload;
+            return ColorMatches(text->textColor, config->textColor) && text->fontId == config->fontId && text->fontSize == config->fontSize
+                && text->letterSpacing == config->letterSpacing && text->lineHeight == config->lineHeight
+                && text->length == (uint32_t)renderCommand->text.length && memcmp(text + 1, renderCommand->text.chars, text->length) == 0;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            Clay_PackedImage *image = (Clay_PackedImage *)payload;
+            return image->imageData == renderCommand->config.imageElementConfig->imageData
+                && memcmp(&image->sourceDimensions, &renderCommand->config.imageElementConfig->sourceDimensions, sizeof(Clay_Dimensions)) == 0;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: return ((Clay_PackedCustom *)payload)->customElementConfig == renderCommand->config.customElementConfig;
+        default: return true;
+    }
+}
+
+int TestPackRoundTrip(void) {
+    Clay_RenderCommandArray renderCommands = LayoutTestFrame();
+    uint32_t streamSize = Clay_PackRenderCommands(renderCommands, NULL, 0);
+    if (streamSize == 0 || streamSize % 8 != 0) {
+        printf("TestPackRoundTrip: expected a non zero multiple of 8 bytes, got %u\n", streamSize);
+        return 1;
+    }
+    uint64_t *buffer = (uint64_t *)malloc(streamSize + 8);
+    uint8_t *stream = (uint8_t *)buffer;
+    // A buffer that is too small is left untouched
+    memset(stream, 0xab, streamSize + 8);
+    if (Clay_PackRenderCommands(renderCommands, stream, streamSize - 8) != streamSize || stream[0] != 0xab) {
+        printf("TestPackRoundTrip: expected a buffer that is too small to be left untouched\n");
+        free(buffer);
+        return 1;
+    }
+    int failures = 0;
+    if (Clay_PackRenderCommands(renderCommands, stream, streamSize) != streamSize || stream[streamSize] != 0xab) {
+        printf("TestPackRoundTrip: expected exactly %u bytes to be written\n", streamSize);
+        failures++;
+    }
+    uint32_t offset = 0;
+    uint32_t seenTypes = 0;
+    for (uint32_t i = 0; i < renderCommands.length && failures == 0; ++i) {
+        Clay_RenderCommand *renderCommand = &renderCommands.internalArray[i];
+        if (renderCommand->commandType == CLAY_RENDER_COMMAND_TYPE_NONE) {
+            continue;
+        }
+        Clay_PackedRenderCommand *command = (Clay_PackedRenderCommand *)(stream + offset);
+        if (offset + command->size * 8 > streamSize || !PackedCommandMatches(command, renderCommand)) {
+            printf("TestPackRoundTrip: packed command at offset %u doesn't match render command %u\n", offset, i);
+            failures++;
+        }
+        seenTypes |= 1u << renderCommand->commandType;
+        offset += command->size * 8;
+    }
+    if (failures == 0 && offset != streamSize) {
+        printf("TestPackRoundTrip: expected the stream to end after %u bytes, it ended after %u\n", offset, streamSize);
+        failures++;
+    }
+    uint32_t expectedTypes = (1u << CLAY_RENDER_COMMAND_TYPE_RECTANGLE) | (1u << CLAY_RENDER_COMMAND_TYPE_BORDER) | (1u << CLAY_RENDER_COMMAND_TYPE_TEXT) | (1u << CLAY_RENDER_COMMAND_TYPE_IMAGE) | (1u << CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) | (1u << CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) | (1u << CLAY_RENDER_COMMAND_TYPE_CUSTOM);
+    if (failures == 0 && seenTypes != expectedTypes) {
+        printf("TestPackRoundTrip: expected every kind of render command to be packed\n");
+        failures++;
+    }
+    // Padding is zeroed, so the same frame packs to the same bytes
+    uint8_t *repeated = (uint8_t *)malloc(streamSize);
+    memset(repeated, 0xcd, streamSize);
+    Clay_PackRenderCommands(LayoutTestFrame(), repeated, streamSize);
+    if (memcmp(stream, repeated, streamSize) != 0) {
+        printf("TestPackRoundTrip: expected the same frame to pack to the same bytes\n");
+        failures++;
+    }
+    free(repeated);
+    free(buffer);
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = TestPackRoundTrip();
+    if (failures > 0 || errorCount > 0) {
+        printf("Packed render command tests failed\n");
+        return 1;
+    }
+    printf("Packed render command tests passed\n");
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Tests for Clay_EndLayoutDiff, which compares each frame's render commands against the frame before it
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+// A row of three boxes. offset pushes the last box to the right, and color changes the middle one.
+Clay_RenderCommandDiff LayoutTestFrame(float offset, Clay_Color color, bool includeLastBox) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Row"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIT(), CLAY_SIZING_FIT() }, .childGap = 10 })) {
+        CLAY(CLAY_ID("First"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_FIXED(50) } }), CLAY_RECTANGLE({ .color = {255, 0, 0, 255} })) {}
+        CLAY(CLAY_ID("Second"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_FIXED(50) } }), CLAY_RECTANGLE({ .color = color })) {
+            CLAY_TEXT(CLAY_STRING("text"), CLAY_TEXT_CONFIG({ .textColor = {255, 255, 255, 255}, .fontSize = 10 }));
+        }
+        CLAY(CLAY_ID("Spacer"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(offset) } })) {}
+        if (includeLastBox) {
+            CLAY(CLAY_ID("Last"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_FIXED(50) } }), CLAY_RECTANGLE({ .color = {0, 0, 255, 255} })) {}
+        }
+    }
+    return Clay_EndLayoutDiff();
+}
+
+int ExpectDiffLengths(const char *name, Clay_RenderCommandDiff diff, uint32_t added, uint32_t removed, uint32_t moved, uint32_t changed) {
+    if (diff.added.length != added || diff.removed.length != removed || diff.moved.length != moved || diff.changed.length != changed) {
+        printf("%s: expected %u added, %u removed, %u moved and %u changed, got %u, %u, %u and %u\n", name, added, removed, moved, changed, diff.added.length, diff.removed.length, diff.moved.length, diff.changed.length);
+        return 1;
+    }
+    return 0;
+}
+
+// Every command is new on the first frame, and nothing differs when the same frame is laid out again
+int TestIdenticalFramesGiveEmptyDiff(void) {
+    Clay_Color green = {0, 255, 0, 255};
+    Clay_RenderCommandDiff diff = LayoutTestFrame(10, green, true);
+    int failures = ExpectDiffLengths("TestIdenticalFramesGiveEmptyDiff (first frame)", diff, diff.renderCommands.length, 0, 0, 0);
+    for (int frame = 0; frame < 2; ++frame) {
+        diff = LayoutTestFrame(10, green, true);
+        failures += ExpectDiffLengths("TestIdenticalFramesGiveEmptyDiff", diff, 0, 0, 0, 0);
+        if (diff.damageRectangles.length != 0) {
+            printf("TestIdenticalFramesGiveEmptyDiff: expected no damage rectangles, got %u\n", diff.damageRectangles.length);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// Moving an element reports it as moved, with its new bounding box, and leaves the others alone
+int TestMovedElementIsReported(void) {
+    Clay_Color green = {0, 255, 0, 255};
+    LayoutTestFrame(10, green, true);
+    Clay_RenderCommandDiff diff = LayoutTestFrame(40, green, true);
+    int failures = ExpectDiffLengths("TestMovedElementIsReported", diff, 0, 0, 1, 0);
+    if (failures == 0) {
+        Clay_RenderCommand *moved = &diff.moved.internalArray[0];
+        if (moved->id != Clay_GetElementId(CLAY_STRING("Last")).id || moved->commandType != CLAY_RENDER_COMMAND_TYPE_RECTANGLE || moved->boundingBox.x != 170) {
+            printf("TestMovedElementIsReported: expected the last box to move to x 170, got id %u at x %g\n", moved->id, moved->boundingBox.x);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// A different config is reported as changed rather than moved, even though the bounding box is the same
+int TestChangedConfigIsReported(void) {
+    LayoutTestFrame(10, (Clay_Color) {0, 255, 0, 255}, true);
+    Clay_RenderCommandDiff diff = LayoutTestFrame(10, (Clay_Color) {0, 128, 0, 255}, true);
+    int failures = ExpectDiffLengths("TestChangedConfigIsReported", diff, 0, 0, 0, 1);
+    if (failures == 0 && diff.changed.internalArray[0].id != Clay_GetElementId(CLAY_STRING("Second")).id) {
+        printf("TestChangedConfigIsReported: expected the second box to change, got id %u\n", diff.changed.internalArray[0].id);
+        failures++;
+    }
+    return failures;
+}
+
+// Commands that disappear are reported as removed with their old bounding box, and come back as added
+int TestRemovedAndAddedElements(void) {
+    Clay_Color green = {0, 255, 0, 255};
+    LayoutTestFrame(10, green, true);
+    Clay_RenderCommandDiff diff = LayoutTestFrame(10, green, false);
+    int failures = ExpectDiffLengths("TestRemovedAndAddedElements (removed)", diff, 0, 1, 0, 0);
+    if (failures == 0 && (diff.removed.internalArray[0].id != Clay_GetElementId(CLAY_STRING("Last")).id || diff.removed.internalArray[0].boundingBox.x != 140)) {
+        printf("TestRemovedAndAddedElements: expected the last box to be removed from x 140, got id %u at x %g\n", diff.removed.internalArray[0].id, diff.removed.internalArray[0].boundingBox.x);
+        failures++;
+    }
+    diff = LayoutTestFrame(10, green, true);
+    failures += ExpectDiffLengths("TestRemovedAndAddedElements (added)", diff, 1, 0, 0, 0);
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize() + Clay_OptionalFeatureMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = 0;
+    failures += TestIdenticalFramesGiveEmptyDiff();
+    failures += TestMovedElementIsReported();
+    failures += TestChangedConfigIsReported();
+    failures += TestRemovedAndAddedElements();
+    if (failures > 0 || errorCount > 0) {
+        printf("Render command diff tests failed\n");
+        return 1;
+    }
+    printf("Render command diff tests passed\n");
+    return 0;
+}
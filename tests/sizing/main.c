@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Regression tests for sizing. Clay__DistributeSizeAmongChildren is checked against the loop it replaced, which divided
+// the remaining size evenly between the children that could still change size until nothing was left to distribute.
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+typedef struct {
+    float size;
+    float sizingMin;
+    float sizingMax;
+    float minSize;
+} TestChild;
+
+float ClampChildSize(TestChild *child, float size) {
+    return CLAY__MAX(CLAY__MAX(CLAY__MIN(child->sizingMax, size), child->sizingMin), child->minSize);
+}
+
+// The distribution loop as it was before it was replaced with a solver, for children that are all resizable containers.
+// Snapping children back inside their limits can use up more than the size being distributed, and the loop then checks
+// the children after that against the opposite direction, so its result depends on the order they were visited in.
+// signChanged is set when that happens, as the solver doesn't reproduce it.
+float OldDistributeSizeAmongChildren(float sizeToDistribute, TestChild *children, int32_t childCount, bool *signChanged) {
+    bool growing = sizeToDistribute > 0;
+    *signChanged = false;
+    int32_t remainingElements[16];
+    int32_t remainingCount = childCount;
+    for (int32_t i = 0; i < childCount; ++i) {
+        remainingElements[i] = i;
+    }
+    while (sizeToDistribute != 0 && remainingCount > 0) {
+        float dividedSize = sizeToDistribute / (float)remainingCount;
+        for (int32_t childOffset = 0; childOffset < remainingCount; childOffset++) {
+            TestChild *child = &children[remainingElements[childOffset]];
+            if ((sizeToDistribute < 0 && child->size == child->sizingMin) || (sizeToDistribute > 0 && child->size == child->sizingMax)) {
+                remainingElements[childOffset--] = remainingElements[--remainingCount];
+                continue;
+            }
+            float oldChildSize = child->size;
+            child->size = ClampChildSize(child, child->size + dividedSize);
+            float diff = child->size - oldChildSize;
+            if (diff > -0.01 && diff < 0.01) {
+                remainingElements[childOffset--] = remainingElements[--remainingCount];
+                continue;
+            }
+            sizeToDistribute -= diff;
+            *signChanged = *signChanged || (growing ? sizeToDistribute < 0 : sizeToDistribute > 0);
+        }
+    }
+    return (sizeToDistribute > -0.01 && sizeToDistribute < 0.01) ? 0 : sizeToDistribute;
+}
+
+// Runs the current solver on the same children, by writing them into the first layout elements' axis data
+float NewDistributeSizeAmongChildren(float sizeToDistribute, TestChild *children, int32_t childCount) {
+    Clay_Context *context = Clay_GetCurrentContext();
+    Clay__LayoutElementAxisData *axisData = &context->layoutElementAxisData;
+    int32_t childIndexes[16];
+    for (int32_t i = 0; i < childCount; ++i) {
+        axisData->sizes.internalArray[i] = children[i].size;
+        axisData->sizingMins.internalArray[i] = children[i].sizingMin;
+        axisData->sizingMaxes.internalArray[i] = children[i].sizingMax;
+        axisData->minSizes.internalArray[i] = children[i].minSize;
+        axisData->sizingTypes.internalArray[i] = CLAY__SIZING_TYPE_FIT;
+        axisData->flags.internalArray[i] = CLAY__LAYOUT_ELEMENT_AXIS_FLAG_RESIZABLE;
+        childIndexes[i] = i;
+    }
+    Clay__int32_tArray resizableContainerBuffer = { .capacity = (uint32_t)childCount, .length = (uint32_t)childCount, .internalArray = childIndexes };
+    Clay__SizingScratch scratch = Clay__SizingScratchSlice(0, (uint32_t)childCount);
+    float remainder = Clay__DistributeSizeAmongChildren(true, sizeToDistribute, resizableContainerBuffer, CLAY__SIZE_DISTRIBUTION_TYPE_RESIZEABLE_CONTAINER, &scratch);
+    for (int32_t i = 0; i < childCount; ++i) {
+        children[i].size = axisData->sizes.internalArray[i];
+    }
+    return remainder;
+}
+
+// The old loop stopped once a share moved a child by less than 0.01, so it can be off by that much for every child
+bool NearlyEqual(float a, float b) {
+    return (a > b ? a - b : b - a) < 0.1f;
+}
+
+// Known-good layout edges are only allowed to differ by float rounding
+bool SameEdge(float a, float b) {
+    return (a > b ? a - b : b - a) < 0.001f;
+}
+
+// Returns -1 if the old loop's result depended on the order of the children, and there is nothing to compare
+int CompareDistribution(const char *name, float sizeToDistribute, TestChild *children, int32_t childCount) {
+    TestChild oldChildren[16], newChildren[16];
+    memcpy(oldChildren, children, sizeof(TestChild) * childCount);
+    memcpy(newChildren, children, sizeof(TestChild) * childCount);
+    bool signChanged;
+    float oldRemainder = OldDistributeSizeAmongChildren(sizeToDistribute, oldChildren, childCount, &signChanged);
+    if (signChanged) {
+        return -1;
+    }
+    float newRemainder = NewDistributeSizeAmongChildren(sizeToDistribute, newChildren, childCount);
+    bool matches = NearlyEqual(oldRemainder, newRemainder);
+    for (int32_t i = 0; i < childCount; ++i) {
+        matches = matches && NearlyEqual(oldChildren[i].size, newChildren[i].size);
+    }
+    if (!matches) {
+        printf("%s: distributing %g among %d children gave a different result\n", name, sizeToDistribute, childCount);
+        for (int32_t i = 0; i < childCount; ++i) {
+            printf("  child %d (size %g, min %g, max %g, min size %g): expected %g, got %g\n", i, children[i].size, children[i].sizingMin, children[i].sizingMax, children[i].minSize, oldChildren[i].size, newChildren[i].size);
+        }
+        printf("  remainder: expected %g, got %g\n", oldRemainder, newRemainder);
+        return 1;
+    }
+    return 0;
+}
+
+// Children that start below their min size or above their max are snapped back inside their limits by the first even
+// share, and only what is left after that is shared out
+int TestDistributeChildrenOutsideLimits(void) {
+    TestChild children[] = {
+        { .size = 45, .sizingMin = 26, .sizingMax = 47, .minSize = 54 },
+        { .size = 47, .sizingMin = 10, .sizingMax = CLAY__MAXFLOAT, .minSize = 6 },
+        { .size = 42, .sizingMin = 17, .sizingMax = 42, .minSize = 28 },
+        { .size = 18, .sizingMin = 41, .sizingMax = 97, .minSize = 55 },
+    };
+    int failures = CompareDistribution("TestDistributeChildrenOutsideLimits", 85, children, 4) != 0;
+    NewDistributeSizeAmongChildren(85, children, 4);
+    if (children[1].size != 77.125f || children[3].size != 63.875f) {
+        printf("TestDistributeChildrenOutsideLimits: expected sizes 77.125 and 63.875, got %g and %g\n", children[1].size, children[3].size);
+        failures++;
+    }
+    return failures;
+}
+
+// Random children and sizes to distribute, both growing and shrinking, with limits that are often already exceeded
+int TestDistributeMatchesOldLoop(void) {
+    int failures = 0;
+    int comparedCount = 0;
+    srand(1);
+    for (int trial = 0; trial < 20000 && failures < 10; ++trial) {
+        TestChild children[16];
+        int32_t childCount = 1 + rand() % 8;
+        for (int32_t i = 0; i < childCount; ++i) {
+            children[i].size = (float)(rand() % 100);
+            children[i].sizingMin = (float)(rand() % 60);
+            children[i].sizingMax = rand() % 4 == 0 ? CLAY__MAXFLOAT : children[i].sizingMin + (float)(rand() % 80);
+            children[i].minSize = (float)(rand() % 60);
+        }
+        float sizeToDistribute = (float)(rand() % 301 - 150) + (float)(rand() % 4) * 0.25f;
+        int result = CompareDistribution("TestDistributeMatchesOldLoop", sizeToDistribute, children, childCount);
+        if (result >= 0) {
+            failures += result;
+            comparedCount++;
+        }
+    }
+    // Most children start inside their limits in real layouts, but the comparison should still cover plenty of cases
+    if (comparedCount < 10000) {
+        printf("TestDistributeMatchesOldLoop: only %d of the random cases could be compared\n", comparedCount);
+        failures++;
+    }
+    return failures;
+}
+
+typedef struct {
+    const char *name;
+    uint32_t index;
+    Clay_BoundingBox boundingBox;
+} ExpectedBox;
+
+// Every element in the known-good layouts has a rectangle, so its bounding box can be found in the render commands
+#define BOX(name, ...) CLAY(CLAY_ID(name), CLAY_LAYOUT(__VA_ARGS__), CLAY_RECTANGLE({ .color = {100, 100, 100, 255} }))
+
+// CLAY_SIZING_GROW and CLAY_SIZING_FIT only take a single field
+Clay_SizingAxis SizingBetween(Clay__SizingType type, float min, float max) {
+    return (Clay_SizingAxis) { .size = { .minMax = { min, max } }, .type = type };
+}
+
+Clay_TextElementConfig *TextConfig(void) { return CLAY_TEXT_CONFIG({ .textColor = {255, 255, 255, 255}, .fontSize = 10 }); }
+
+// GROW, FIT, PERCENT and FIXED children in one row, with min and max sizes on the grow children
+void LayoutMixedRow(void) {
+    BOX("Root", { .sizing = { CLAY_SIZING_FIXED(600), CLAY_SIZING_FIXED(100) }, .padding = {10, 5}, .childGap = 10 }) {
+        BOX("GrowLimited", { .sizing = { SizingBetween(CLAY__SIZING_TYPE_GROW, 50, 120), CLAY_SIZING_GROW() } }) {}
+        BOX("Fit", { .padding = {4, 4} }) {
+            CLAY_TEXT(CLAY_STRING("fit text"), TextConfig());
+        }
+        BOX("Percent", { .sizing = { CLAY_SIZING_PERCENT(0.25f), CLAY_SIZING_PERCENT(0.5f) } }) {}
+        BOX("Fixed", { .sizing = { CLAY_SIZING_FIXED(80), CLAY_SIZING_FIXED(30) } }) {}
+        BOX("Grow", { .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW({ .max = 40 }) } }) {}
+    }
+}
+
+// Grow children whose min size is above an even share keep it, and the rest share what is left
+void LayoutGrowMinSizes(void) {
+    BOX("Root", { .sizing = { CLAY_SIZING_FIXED(500), CLAY_SIZING_FIXED(50) }, .childGap = 5 }) {
+        BOX("GrowMin200", { .sizing = { CLAY_SIZING_GROW({ .min = 200 }), CLAY_SIZING_GROW() } }) {}
+        BOX("GrowMin150", { .sizing = { CLAY_SIZING_GROW({ .min = 150 }), CLAY_SIZING_GROW() } }) {}
+        BOX("GrowMax40", { .sizing = { CLAY_SIZING_GROW({ .max = 40 }), CLAY_SIZING_GROW() } }) {}
+        BOX("Grow", { .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() } }) {}
+        BOX("GrowContent", { .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW() } }) {
+            BOX("Content", { .sizing = { CLAY_SIZING_FIXED(90), CLAY_SIZING_FIXED(10) } }) {}
+        }
+    }
+}
+
+// Content wider than the row is shrunk down to the min sizes of the resizable children, wrapping their text
+void LayoutShrinkRow(void) {
+    BOX("Root", { .sizing = { CLAY_SIZING_FIXED(300), CLAY_SIZING_FIT() }, .padding = {8, 8}, .childGap = 5 }) {
+        BOX("FitText", { .sizing = { CLAY_SIZING_FIT({ .min = 60 }) } }) {
+            CLAY_TEXT(CLAY_STRING("alpha beta gamma delta"), TextConfig());
+        }
+        BOX("FitWideText", { .padding = {2, 2} }) {
+            CLAY_TEXT(CLAY_STRING("epsilon zeta eta theta iota"), TextConfig());
+        }
+        BOX("GrowMin", { .sizing = { CLAY_SIZING_GROW({ .min = 40 }), CLAY_SIZING_GROW() } }) {}
+        BOX("Fixed", { .sizing = { CLAY_SIZING_FIXED(100), CLAY_SIZING_FIXED(20) } }) {}
+    }
+}
+
+// Children whose content is wider than their max size, or narrower than their min size, start outside their limits
+void LayoutChildrenOutsideLimits(void) {
+    BOX("Root", { .sizing = { CLAY_SIZING_FIXED(400), CLAY_SIZING_FIXED(60) }, .childGap = 4 }) {
+        BOX("FitMaxBelowContent", { .sizing = { CLAY_SIZING_FIT({ .max = 50 }) } }) {
+            BOX("WideContent", { .sizing = { CLAY_SIZING_FIXED(80), CLAY_SIZING_FIXED(20) } }) {}
+        }
+        BOX("FitMinAboveContent", { .sizing = { CLAY_SIZING_FIT({ .min = 120 }) } }) {
+            BOX("NarrowContent", { .sizing = { CLAY_SIZING_FIXED(20), CLAY_SIZING_FIXED(20) } }) {}
+        }
+        BOX("GrowMaxBelowContent", { .sizing = { CLAY_SIZING_GROW({ .max = 30 }), CLAY_SIZING_GROW() } }) {
+            BOX("GrowContent", { .sizing = { CLAY_SIZING_FIXED(60), CLAY_SIZING_FIXED(20) } }) {}
+        }
+        BOX("GrowText", { .sizing = { CLAY_SIZING_GROW({ .min = 70 }), CLAY_SIZING_GROW() } }) {
+            CLAY_TEXT(CLAY_STRING("one two three four five six"), TextConfig());
+        }
+    }
+}
+
+// The same limits along the y axis, where wrapped text grows its parents' heights
+void LayoutColumn(void) {
+    BOX("Root", { .sizing = { CLAY_SIZING_FIXED(120), CLAY_SIZING_FIXED(400) }, .padding = {6, 6}, .childGap = 6, .layoutDirection = CLAY_TOP_TO_BOTTOM }) {
+        BOX("WrappedText", { .sizing = { CLAY_SIZING_GROW() }, .padding = {3, 3} }) {
+            CLAY_TEXT(CLAY_STRING("a column of words that has to wrap"), TextConfig());
+        }
+        BOX("GrowHeight", { .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW({ .max = 200 }) } }) {}
+        BOX("PercentHeight", { .sizing = { CLAY_SIZING_FIXED(50), CLAY_SIZING_PERCENT(0.2f) } }) {}
+        BOX("GrowHeightMin", { .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_GROW({ .min = 30 }) } }) {}
+        BOX("FitHeight", { .sizing = { CLAY_SIZING_FIT(), CLAY_SIZING_FIT({ .max = 25 }) } }) {
+            BOX("TallContent", { .sizing = { CLAY_SIZING_FIXED(40), CLAY_SIZING_FIXED(60) } }) {}
+        }
+    }
+}
+
+// A column whose children are taller than it, shrinking the scroll container below its content
+void LayoutShrinkColumn(void) {
+    BOX("Root", { .sizing = { CLAY_SIZING_FIXED(200), CLAY_SIZING_FIXED(150) }, .childGap = 10, .layoutDirection = CLAY_TOP_TO_BOTTOM }) {
+        CLAY(CLAY_ID("Scroll"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW() }, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_SCROLL({ .vertical = true })) {
+            for (int i = 0; i < 4; ++i) {
+                CLAY(CLAY_IDI("Item", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_FIXED(40) } }), CLAY_RECTANGLE({ .color = {100, 100, 100, 255} })) {}
+            }
+        }
+        BOX("FitMin", { .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_FIT({ .min = 50 }) } }) {
+            BOX("FitContent", { .sizing = { CLAY_SIZING_FIXED(20), CLAY_SIZING_FIXED(80) } }) {}
+        }
+    }
+}
+
+// Bounding boxes from the layouts above before the sizing changes, which these layouts must keep giving
+ExpectedBox expectedMixedRow[] = {
+    { "Root", 0, { 0, 0, 600, 100 } },
+    { "GrowLimited", 0, { 10, 5, 113.5, 90 } },
+    { "Fit", 0, { 133.5, 5, 88, 18 } },
+    { "Percent", 0, { 231.5, 5, 135, 45 } },
+    { "Fixed", 0, { 376.5, 5, 80, 30 } },
+    { "Grow", 0, { 466.5, 5, 113.5, 40 } },
+};
+
+ExpectedBox expectedGrowMinSizes[] = {
+    { "Root", 0, { 0, 0, 500, 50 } },
+    { "GrowMin200", 0, { 0, 0, 200, 50 } },
+    { "GrowMin150", 0, { 205, 0, 150, 50 } },
+    { "GrowMax40", 0, { 360, 0, 20, 50 } },
+    { "Grow", 0, { 385, 0, 20, 50 } },
+    { "GrowContent", 0, { 410, 0, 90, 50 } },
+    { "Content", 0, { 410, 0, 90, 10 } },
+};
+
+ExpectedBox expectedShrinkRow[] = {
+    { "Root", 0, { 0, 0, 300, 70 } },
+    { "FitText", 0, { 8, 8, 60, 40 } },
+    { "FitWideText", 0, { 73, 8, 69, 54 } },
+    { "GrowMin", 0, { 147, 8, 40, 54 } },
+    { "Fixed", 0, { 192, 8, 100, 20 } },
+};
+
+ExpectedBox expectedChildrenOutsideLimits[] = {
+    { "Root", 0, { 0, 0, 400, 60 } },
+    { "FitMaxBelowContent", 0, { 0, 0, 50, 20 } },
+    { "WideContent", 0, { 0, 0, 80, 20 } },
+    { "FitMinAboveContent", 0, { 54, 0, 120, 20 } },
+    { "NarrowContent", 0, { 54, 0, 20, 20 } },
+    { "GrowMaxBelowContent", 0, { 178, 0, 30, 60 } },
+    { "GrowContent", 0, { 178, 0, 60, 20 } },
+    { "GrowText", 0, { 212, 0, 188, 60 } },
+};
+
+ExpectedBox expectedColumn[] = {
+    { "Root", 0, { 0, 0, 120, 400 } },
+    { "WrappedText", 0, { 6, 6, 108, 46 } },
+    { "GrowHeight", 0, { 6, 58, 108, 107.1 } },
+    { "PercentHeight", 0, { 6, 171.1, 50, 72.8 } },
+    { "GrowHeightMin", 0, { 6, 249.9, 108, 107.1 } },
+    { "FitHeight", 0, { 6, 363, 40, 25 } },
+    { "TallContent", 0, { 6, 363, 40, 60 } },
+};
+
+// The last two items are outside the scroll container and have no render commands
+ExpectedBox expectedShrinkColumn[] = {
+    { "Root", 0, { 0, 0, 200, 150 } },
+    { "Scroll", 0, { 0, 0, 200, 60 } },
+    { "Item", 0, { 0, 0, 200, 40 } },
+    { "Item", 1, { 0, 40, 200, 40 } },
+    { "FitMin", 0, { 0, 70, 200, 80 } },
+    { "FitContent", 0, { 0, 70, 20, 80 } },
+};
+
+int CompareLayout(const char *name, void (*layoutFunction)(void), ExpectedBox *expected, int32_t expectedCount) {
+    Clay_BeginLayout();
+    layoutFunction();
+    Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+    int failures = 0;
+    for (int32_t i = 0; i < expectedCount; ++i) {
+        uint32_t id = Clay_GetElementIdWithIndex((Clay_String) { .length = (int32_t)strlen(expected[i].name), .chars = expected[i].name }, expected[i].index).id;
+        Clay_RenderCommand *renderCommand = NULL;
+        for (int32_t j = 0; j < renderCommands.length && !renderCommand; ++j) {
+            if (renderCommands.internalArray[j].id == id && renderCommands.internalArray[j].commandType != CLAY_RENDER_COMMAND_TYPE_TEXT) {
+                renderCommand = &renderCommands.internalArray[j];
+            }
+        }
+        if (!renderCommand) {
+            printf("%s: no render command for %s %u\n", name, expected[i].name, expected[i].index);
+            failures++;
+            continue;
+        }
+        Clay_BoundingBox a = renderCommand->boundingBox, b = expected[i].boundingBox;
+        if (!SameEdge(a.x, b.x) || !SameEdge(a.y, b.y) || !SameEdge(a.width, b.width) || !SameEdge(a.height, b.height)) {
+            printf("%s: %s %u expected { %g, %g, %g, %g }, got { %g, %g, %g, %g }\n", name, expected[i].name, expected[i].index, b.x, b.y, b.width, b.height, a.x, a.y, a.width, a.height);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// Mixed rows and columns with grow, fit, percent and fixed children, shrinking, and children outside their limits
+int TestKnownGoodLayouts(void) {
+    int failures = 0;
+    failures += CompareLayout("MixedRow", LayoutMixedRow, expectedMixedRow, sizeof(expectedMixedRow) / sizeof(ExpectedBox));
+    failures += CompareLayout("GrowMinSizes", LayoutGrowMinSizes, expectedGrowMinSizes, sizeof(expectedGrowMinSizes) / sizeof(ExpectedBox));
+    failures += CompareLayout("ShrinkRow", LayoutShrinkRow, expectedShrinkRow, sizeof(expectedShrinkRow) / sizeof(ExpectedBox));
+    failures += CompareLayout("ChildrenOutsideLimits", LayoutChildrenOutsideLimits, expectedChildrenOutsideLimits, sizeof(expectedChildrenOutsideLimits) / sizeof(ExpectedBox));
+    failures += CompareLayout("Column", LayoutColumn, expectedColumn, sizeof(expectedColumn) / sizeof(ExpectedBox));
+    failures += CompareLayout("ShrinkColumn", LayoutShrinkColumn, expectedShrinkColumn, sizeof(expectedShrinkColumn) / sizeof(ExpectedBox));
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = 0;
+    failures += TestDistributeChildrenOutsideLimits();
+    failures += TestDistributeMatchesOldLoop();
+    failures += TestKnownGoodLayouts();
+    if (failures > 0 || errorCount > 0) {
+        printf("Sizing tests failed\n");
+        return 1;
+    }
+    printf("Sizing tests passed\n");
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define CLAY_IMPLEMENTATION
+#include "../../clay.h"
+
+// Tests for virtual lists, scroll containers with a non zero virtualItemCount that only declare their visible items
+
+int errorCount = 0;
+
+void HandleClayErrors(Clay_ErrorData errorData) {
+    printf("%.*s\n", (int)errorData.errorText.length, errorData.errorText.chars);
+    errorCount++;
+}
+
+Clay_Dimensions MeasureText(Clay_String *text, Clay_TextElementConfig *config) {
+    return (Clay_Dimensions) { .width = (float)text->length * config->fontSize, .height = config->fontSize };
+}
+
+// 1000 rows of 20 with a gap of 4 between them, in a list 200 high
+#define ROW_COUNT 1000
+#define ROW_PITCH 24
+
+Clay_ScrollContainerData LayoutTestFrame(Clay_RenderCommandArray *renderCommands) {
+    Clay_BeginLayout();
+    Clay_ScrollContainerData rows = {0};
+    CLAY(CLAY_ID("Rows"), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_FIXED(300), CLAY_SIZING_FIXED(200) }, .childGap = 4, .layoutDirection = CLAY_TOP_TO_BOTTOM }), CLAY_SCROLL({ .vertical = true, .virtualItemCount = ROW_COUNT, .virtualItemSize = 20 })) {
+        rows = Clay_GetScrollContainerData(Clay_GetElementId(CLAY_STRING("Rows")));
+        for (uint32_t i = rows.virtualItemsStartIndex; i < rows.virtualItemsEndIndex; i++) {
+            CLAY(CLAY_IDI("Row", i), CLAY_LAYOUT({ .sizing = { CLAY_SIZING_GROW(), CLAY_SIZING_FIXED(20) } }), CLAY_RECTANGLE({ .color = {100, 100, 100, 255} })) {}
+        }
+    }
+    *renderCommands = Clay_EndLayout();
+    return rows;
+}
+
+Clay_RenderCommand *FindRow(Clay_RenderCommandArray renderCommands, uint32_t index) {
+    uint32_t id = Clay_GetElementIdWithIndex(CLAY_STRING("Row"), index).id;
+    for (uint32_t i = 0; i < renderCommands.length; ++i) {
+        if (renderCommands.internalArray[i].id == id) {
+            return &renderCommands.internalArray[i];
+        }
+    }
+    return NULL;
+}
+
+// Lays out the list scrolled to scrollY, and checks which rows were declared and where the first of them was placed
+int ExpectVisibleRange(const char *name, float scrollY, uint32_t expectedStart, uint32_t expectedEnd) {
+    Clay_ScrollContainerData rows = Clay_GetScrollContainerData(Clay_GetElementId(CLAY_STRING("Rows")));
+    rows.scrollPosition->y = -scrollY;
+    Clay_RenderCommandArray renderCommands;
+    rows = LayoutTestFrame(&renderCommands);
+    if (rows.virtualItemsStartIndex != expectedStart || rows.virtualItemsEndIndex != expectedEnd) {
+        printf("%s: expected rows %u to %u to be declared, got %u to %u\n", name, expectedStart, expectedEnd, rows.virtualItemsStartIndex, rows.virtualItemsEndIndex);
+        return 1;
+    }
+    Clay_RenderCommand *firstRow = FindRow(renderCommands, expectedStart);
+    float expectedY = (float)(expectedStart * ROW_PITCH) - scrollY;
+    if (!firstRow || firstRow->boundingBox.y != expectedY) {
+        printf("%s: expected row %u at y %g, got %g\n", name, expectedStart, expectedY, firstRow ? firstRow->boundingBox.y : -1);
+        return 1;
+    }
+    return 0;
+}
+
+int TestVisibleRange(void) {
+    Clay_RenderCommandArray renderCommands;
+    // Before the list has been laid out, it's assumed that it could be as high as the whole layout
+    Clay_ScrollContainerData rows = LayoutTestFrame(&renderCommands);
+    int failures = 0;
+    if (rows.virtualItemsStartIndex != 0 || rows.virtualItemsEndIndex != 768 / ROW_PITCH + 1) {
+        printf("TestVisibleRange (first frame): expected rows 0 to %u to be declared, got %u to %u\n", 768 / ROW_PITCH + 1, rows.virtualItemsStartIndex, rows.virtualItemsEndIndex);
+        failures++;
+    }
+    rows = LayoutTestFrame(&renderCommands);
+    if (rows.contentDimensions.height != ROW_COUNT * ROW_PITCH - 4) {
+        printf("TestVisibleRange: expected the content to be %d high, got %g\n", ROW_COUNT * ROW_PITCH - 4, rows.contentDimensions.height);
+        failures++;
+    }
+    failures += ExpectVisibleRange("TestVisibleRange (top)", 0, 0, 9);
+    failures += ExpectVisibleRange("TestVisibleRange (whole rows)", 240, 10, 19);
+    failures += ExpectVisibleRange("TestVisibleRange (part rows)", 250, 10, 19);
+    failures += ExpectVisibleRange("TestVisibleRange (bottom)", ROW_COUNT * ROW_PITCH - 4 - 200, 991, ROW_COUNT);
+    return failures;
+}
+
+int main(void) {
+    uint32_t totalMemorySize = Clay_MinMemorySize();
+    char *memory = (char *)malloc(totalMemorySize);
+    memset(memory, 0x7f, totalMemorySize);
+    Clay_Initialize(Clay_CreateArenaWithCapacityAndMemory(totalMemorySize, memory), (Clay_Dimensions) {1024, 768}, (Clay_ErrorHandler) { HandleClayErrors });
+    Clay_SetMeasureTextFunction(MeasureText);
+    int failures = TestVisibleRange();
+    if (failures > 0 || errorCount > 0) {
+        printf("Virtual list tests failed\n");
+        return 1;
+    }
+    printf("Virtual list tests passed\n");
+    return 0;
+}